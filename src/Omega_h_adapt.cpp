@@ -76,10 +76,11 @@ AdaptOpts::AdaptOpts(Int dim) {
   length_histogram_max = 3.0;
   nlength_histogram_bins = 10;
   nquality_histogram_bins = 10;
+  snap_smooth_tolerance = 1e-6;
+  snap_smooth_max_iters = 1000;
 #ifdef OMEGA_H_USE_EGADS
   egads_model = nullptr;
   should_smooth_snap = true;
-  snap_smooth_tolerance = 1e-2;
   allow_snap_failure = false;
 #endif
   should_refine = true;
@@ -87,6 +88,7 @@ AdaptOpts::AdaptOpts(Int dim) {
   should_swap = true;
   should_coarsen_slivers = true;
   should_prevent_coarsen_flip = false;
+  should_refine_in_batch = false;
 }
 
 static Reals get_fixable_qualities(Mesh* mesh, AdaptOpts const&) {
@@ -217,6 +219,21 @@ static bool satisfy_quality(Mesh* mesh, AdaptOpts const& opts) {
   return true;
 }
 
+Reals smooth_snap_warp(Mesh* mesh, Reals warp, AdaptOpts const& opts) {
+  if (opts.verbosity >= EACH_REBUILD && can_print(mesh)) {
+    std::cout << "Solving Laplacian of warp field...\n";
+  }
+  auto t0 = now();
+  auto smooth = solve_laplacian_cg(mesh, warp, mesh->dim(),
+      opts.snap_smooth_tolerance, true, opts.snap_smooth_max_iters);
+  auto t1 = now();
+  if (opts.verbosity >= EACH_REBUILD && can_print(mesh)) {
+    std::cout << "Solving Laplacian of warp field took " << (t1 - t0)
+              << " seconds\n";
+  }
+  return smooth;
+}
+
 static void snap_and_satisfy_quality(Mesh* mesh, AdaptOpts const& opts) {
 #ifdef OMEGA_H_USE_EGADS
   if (opts.egads_model) {
@@ -224,19 +241,7 @@ static void snap_and_satisfy_quality(Mesh* mesh, AdaptOpts const& opts) {
     mesh->set_parting(OMEGA_H_GHOSTED);
     auto warp = egads_get_snap_warp(
         mesh, opts.egads_model, opts.verbosity >= EACH_REBUILD);
-    if (opts.should_smooth_snap) {
-      if (opts.verbosity >= EACH_REBUILD) {
-        std::cout << "Solving Laplacian of warp field...\n";
-      }
-      auto t0 = now();
-      warp =
-          solve_laplacian(mesh, warp, mesh->dim(), opts.snap_smooth_tolerance);
-      auto t1 = now();
-      if (opts.verbosity >= EACH_REBUILD) {
-        std::cout << "Solving Laplacian of warp field took " << (t1 - t0)
-                  << " seconds\n";
-      }
-    }
+    if (opts.should_smooth_snap) warp = smooth_snap_warp(mesh, warp, opts);
     mesh->add_tag(VERT, "warp", mesh->dim(), warp);
     while (warp_to_limit(mesh, opts, opts.allow_snap_failure)) {
       if (!satisfy_quality(mesh, opts)) {
@@ -49,10 +49,15 @@ struct AdaptOpts {
   Real length_histogram_max;
   Int nlength_histogram_bins;
   Int nquality_histogram_bins;
+  /* smooth_snap_warp() stops once the residual norm has dropped by
+     this factor, or after this many iterations. the default gives a
+     nearly harmonic warp, which the multigrid preconditioner reaches
+     in a few dozen iterations */
+  Real snap_smooth_tolerance;
+  Int snap_smooth_max_iters;
 #ifdef OMEGA_H_USE_EGADS
   Egads* egads_model;
   bool should_smooth_snap;
-  Real snap_smooth_tolerance;
   bool allow_snap_failure;
 #endif
   bool should_refine;
@@ -60,6 +65,9 @@ struct AdaptOpts {
   bool should_swap;
   bool should_coarsen_slivers;
   bool should_prevent_coarsen_flip;
+  /* split all long edges in one rebuild when possible,
+     see Omega_h_refine_batch.hpp */
+  bool should_refine_in_batch;
   TransferOpts xfer_opts;
 };
 
@@ -74,6 +82,9 @@ void print_adapt_histograms(Mesh* mesh, AdaptOpts const& opts);
 void fix_momentum_velocity_verts(
     Mesh* mesh, std::vector<ClassPair> const& class_pairs, Int comp);
 
+/* extends the boundary values of (warp) smoothly into the interior
+   by solving a Laplace equation, see snap_smooth_tolerance */
+Reals smooth_snap_warp(Mesh* mesh, Reals warp, AdaptOpts const& opts);
 bool warp_to_limit(Mesh* mesh, AdaptOpts const& opts,
     bool exit_on_stall = false, Int max_niters = 40);
 bool approach_metric(Mesh* mesh, AdaptOpts const& opts, Real min_step = 1e-4);
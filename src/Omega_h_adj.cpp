@@ -2,6 +2,7 @@
 
 #include "Omega_h_align.hpp"
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_atomics.hpp"
 #include "Omega_h_control.hpp"
 #include "Omega_h_element.hpp"
 #include "Omega_h_loop.hpp"
@@ -135,12 +136,100 @@ static LOs find_unique_deg(Int deg, LOs uv2v) {
   return unmap<LO>(e2u, uv2v, deg);
 }
 
-LOs find_unique(LOs hv2v, Omega_h_Family family, Int high_dim, Int low_dim) {
+/* The hash-based engine keeps an open-addressing hash table of
+   entity indices keyed by canonical (sorted) vertex lists.
+   Collisions are resolved by linear probing, and slots are claimed
+   with atomic compare-and-swap so entities can be inserted concurrently.
+   When several entities have the same vertices their slot ends up
+   holding the largest of their indices, which is also the
+   representative that find_canonical_jumps picks after the stable sort
+   in find_unique_deg. */
+
+static LO get_hash_capacity(LO n) {
+  LO capacity = 1;
+  while (capacity < 2 * n) capacity *= 2;
+  return capacity;
+}
+
+template <typename T>
+OMEGA_H_DEVICE std::uint32_t hash_verts(Int deg, Read<T> const& canon, LO e) {
+  std::uint64_t h = 0;
+  for (Int j = 0; j < deg; ++j) {
+    h = (h ^ std::uint64_t(canon[e * deg + j])) * 0x9E3779B97F4A7C15ULL;
+  }
+  return std::uint32_t(h >> 32);
+}
+
+template <typename T>
+OMEGA_H_DEVICE bool are_equal_verts(
+    Int deg, Read<T> const& a_canon, LO a, Read<T> const& b_canon, LO b) {
+  for (Int j = 0; j < deg; ++j) {
+    if (a_canon[a * deg + j] != b_canon[b * deg + j]) return false;
+  }
+  return true;
+}
+
+/* returns the slot of the table that (e) was merged into */
+template <typename T>
+OMEGA_H_DEVICE LO insert_verts(
+    Int deg, Read<T> const& canon, Write<LO> const& table, LO e) {
+  auto mask = table.size() - 1;
+  auto slot = LO(hash_verts(deg, canon, e) & std::uint32_t(mask));
+  while (true) {
+    auto old = atomic_compare_exchange<LO>(&table[slot], -1, e);
+    if (old == -1) return slot;
+    if (are_equal_verts(deg, canon, old, canon, e)) {
+      while (old < e) {
+        auto prev = atomic_compare_exchange<LO>(&table[slot], old, e);
+        if (prev == old) break;
+        old = prev;
+      }
+      return slot;
+    }
+    slot = (slot + 1) & mask;
+  }
+}
+
+template <typename T>
+static Write<LO> hash_verts_table(
+    Int deg, Read<T> canon, Read<I8>* is_rep_out) {
+  auto n = divide_no_remainder(canon.size(), deg);
+  Write<LO> table(get_hash_capacity(n), -1);
+  Write<LO> slots(n);
+  auto insert = OMEGA_H_LAMBDA(LO e) {
+    slots[e] = insert_verts(deg, canon, table, e);
+  };
+  parallel_for(n, insert, "hash_verts(insert)");
+  Write<I8> is_rep(n);
+  auto mark = OMEGA_H_LAMBDA(LO e) { is_rep[e] = (table[slots[e]] == e); };
+  parallel_for(n, mark, "hash_verts(mark)");
+  *is_rep_out = is_rep;
+  return table;
+}
+
+static LOs find_unique_deg_by_hashing(Int deg, LOs uv2v) {
+  auto codes = get_codes_to_canonical(deg, uv2v);
+  auto uv2v_canon = align_ev2v(deg, uv2v, codes);
+  Read<I8> is_rep;
+  hash_verts_table(deg, uv2v_canon, &is_rep);
+  auto reps2u = collect_marked(is_rep);
+  /* the unique entities are far fewer than their uses, and putting
+     them in sorted order keeps the result identical to
+     that of find_unique_deg */
+  auto reps_canon = unmap(reps2u, uv2v_canon, deg);
+  auto e2reps = sort_by_keys(reps_canon, deg);
+  auto e2u = compound_maps(e2reps, reps2u);
+  return unmap<LO>(e2u, uv2v, deg);
+}
+
+LOs find_unique(LOs hv2v, Omega_h_Family family, Int high_dim, Int low_dim,
+    DedupMethod method) {
   OMEGA_H_CHECK(high_dim > low_dim);
   OMEGA_H_CHECK(low_dim <= 2);
   OMEGA_H_CHECK(hv2v.size() % element_degree(family, high_dim, VERT) == 0);
   auto uv2v = form_uses(hv2v, family, high_dim, low_dim);
   auto deg = element_degree(family, low_dim, VERT);
+  if (method == DEDUP_BY_HASHING) return find_unique_deg_by_hashing(deg, uv2v);
   return find_unique_deg(deg, uv2v);
 }
 
@@ -223,6 +312,66 @@ Adj invert_adj(Adj down, Int nlows_per_high, LO nlows) {
   return Adj(l2lh, lh2h, codes);
 }
 
+Adj update_up_adj(Adj old_l2h, LOs old_lows2new_lows, LOs old_highs2new_highs,
+    LO nnew_lows, Adj prods2new_lows, LOs prods2new_highs,
+    Int nlows_per_high) {
+  begin_code("update_up_adj");
+  auto nold_lows = old_lows2new_lows.size();
+  OMEGA_H_CHECK(old_l2h.a2ab.size() == nold_lows + 1);
+  Write<LO> new_lows2old_lows(nnew_lows, -1);
+  auto invert_lows = OMEGA_H_LAMBDA(LO old_low) {
+    auto new_low = old_lows2new_lows[old_low];
+    if (new_low >= 0) new_lows2old_lows[new_low] = old_low;
+  };
+  parallel_for(nold_lows, invert_lows, "update_up_adj(invert_lows)");
+  /* only the entities produced by the rebuild are inverted from scratch */
+  auto l2p = invert_adj(prods2new_lows, nlows_per_high, nnew_lows);
+  auto l2lp = l2p.a2ab;
+  auto lp2p = l2p.ab2b;
+  auto lp_codes = l2p.codes;
+  auto old_l2lh = old_l2h.a2ab;
+  auto old_lh2h = old_l2h.ab2b;
+  auto old_lh_codes = old_l2h.codes;
+  Write<LO> degrees(nnew_lows);
+  auto count = OMEGA_H_LAMBDA(LO l) {
+    auto old_l = new_lows2old_lows[l];
+    LO n = l2lp[l + 1] - l2lp[l];
+    if (old_l >= 0) {
+      for (auto lh = old_l2lh[old_l]; lh < old_l2lh[old_l + 1]; ++lh) {
+        if (old_highs2new_highs[old_lh2h[lh]] >= 0) ++n;
+      }
+    }
+    degrees[l] = n;
+  };
+  parallel_for(nnew_lows, count, "update_up_adj(count)");
+  auto l2lh = offset_scan(LOs(degrees));
+  Write<LO> lh2h(l2lh.last());
+  Write<I8> codes(l2lh.last());
+  auto fill = OMEGA_H_LAMBDA(LO l) {
+    auto old_l = new_lows2old_lows[l];
+    auto lh = l2lh[l];
+    if (old_l >= 0) {
+      for (auto old_lh = old_l2lh[old_l]; old_lh < old_l2lh[old_l + 1];
+           ++old_lh) {
+        auto h = old_highs2new_highs[old_lh2h[old_lh]];
+        if (h < 0) continue;
+        lh2h[lh] = h;
+        codes[lh] = old_lh_codes[old_lh];
+        ++lh;
+      }
+    }
+    for (auto lp = l2lp[l]; lp < l2lp[l + 1]; ++lp) {
+      lh2h[lh] = prods2new_highs[lp2p[lp]];
+      codes[lh] = lp_codes[lp];
+      ++lh;
+    }
+  };
+  parallel_for(nnew_lows, fill, "update_up_adj(fill)");
+  sort_by_high_index(l2lh, lh2h, codes);
+  end_code();
+  return Adj(l2lh, lh2h, codes);
+}
+
 template <Int deg>
 struct IsMatch;
 
@@ -338,6 +487,63 @@ void find_matches_ex(Int deg, LOs a2fv, Read<T> av2v, Read<T> bv2v, Adj v2b,
   }
 }
 
+template <Int deg, typename T>
+static void find_matches_by_hashing_deg(Read<T> av2v, Read<T> bv2v,
+    LOs* a2b_out, Read<I8>* codes_out, bool allow_duplicates) {
+  auto na = divide_no_remainder(av2v.size(), deg);
+  auto av2v_canon = align_ev2v(deg, av2v, get_codes_to_canonical(deg, av2v));
+  auto bv2v_canon = align_ev2v(deg, bv2v, get_codes_to_canonical(deg, bv2v));
+  Read<I8> b_is_rep;
+  Read<LO> table = hash_verts_table(deg, bv2v_canon, &b_is_rep);
+  if (!allow_duplicates && b_is_rep.size()) {
+    OMEGA_H_CHECK(get_min(b_is_rep) == 1);
+  }
+  auto mask = table.size() - 1;
+  Write<LO> a2b(na);
+  Write<I8> codes(na);
+  auto f = OMEGA_H_LAMBDA(LO a) {
+    auto slot = LO(hash_verts(deg, av2v_canon, a) & std::uint32_t(mask));
+    LO b;
+    while (true) {
+      b = table[slot];
+      OMEGA_H_CHECK(b != -1);  // there can't be less than one!
+      if (are_equal_verts(deg, av2v_canon, a, bv2v_canon, b)) break;
+      slot = (slot + 1) & mask;
+    }
+    auto a_begin = a * deg;
+    auto b_begin = b * deg;
+    Int which_down = 0;
+    while (bv2v[b_begin + which_down] != av2v[a_begin]) ++which_down;
+    I8 match_code = 0;
+    auto found = IsMatch<deg>::eval(
+        av2v, a_begin, bv2v, b_begin, which_down, &match_code);
+    OMEGA_H_CHECK(found);
+    a2b[a] = b;
+    codes[a] = match_code;
+  };
+  parallel_for(na, f, "find_matches_by_hashing");
+  *a2b_out = a2b;
+  *codes_out = codes;
+}
+
+template <typename T>
+void find_matches_by_hashing_ex(Int deg, Read<T> av2v, Read<T> bv2v,
+    LOs* a2b_out, Read<I8>* codes_out, bool allow_duplicates) {
+  if (deg == 2) {
+    find_matches_by_hashing_deg<2>(
+        av2v, bv2v, a2b_out, codes_out, allow_duplicates);
+  } else if (deg == 3) {
+    find_matches_by_hashing_deg<3>(
+        av2v, bv2v, a2b_out, codes_out, allow_duplicates);
+  } else if (deg == 4) {
+    find_matches_by_hashing_deg<4>(
+        av2v, bv2v, a2b_out, codes_out, allow_duplicates);
+  } else {
+    Omega_h_fail(
+        "find_matches_by_hashing_ex called with unsupported degree %d\n", deg);
+  }
+}
+
 void find_matches(Omega_h_Family family, Int dim, LOs av2v, LOs bv2v, Adj v2b,
     LOs* a2b_out, Read<I8>* codes_out) {
   OMEGA_H_CHECK(dim <= 2);
@@ -355,6 +561,16 @@ Adj reflect_down(LOs hv2v, LOs lv2v, Adj v2l, Omega_h_Family family,
   return Adj(hl2l, codes);
 }
 
+Adj reflect_down_by_hashing(LOs hv2v, LOs lv2v, Omega_h_Family family,
+    Int high_dim, Int low_dim) {
+  LOs uv2v = form_uses(hv2v, family, high_dim, low_dim);
+  auto deg = element_degree(family, low_dim, VERT);
+  LOs hl2l;
+  Read<I8> codes;
+  find_matches_by_hashing_ex(deg, uv2v, lv2v, &hl2l, &codes);
+  return Adj(hl2l, codes);
+}
+
 Adj reflect_down(LOs hv2v, LOs lv2v, Omega_h_Family family, LO nv, Int high_dim,
     Int low_dim) {
   auto nverts_per_low = element_degree(family, low_dim, 0);
@@ -545,7 +761,9 @@ Graph elements_across_sides(
 #define INST(T)                                                                \
   template Read<I8> get_codes_to_canonical(Int deg, Read<T> ev2v);             \
   template void find_matches_ex(Int deg, LOs a2fv, Read<T> av2v, Read<T> bv2v, \
-      Adj v2b, LOs* a2b_out, Read<I8>* codes_out, bool);
+      Adj v2b, LOs* a2b_out, Read<I8>* codes_out, bool);                       \
+  template void find_matches_by_hashing_ex(Int deg, Read<T> av2v,              \
+      Read<T> bv2v, LOs* a2b_out, Read<I8>* codes_out, bool);
 INST(LO)
 INST(GO)
 #undef INST
@@ -32,12 +32,31 @@ Adj unmap_adjacency(LOs a2b, Adj b2c);
    index of the upward adjacent entity */
 Adj invert_adj(Adj down, Int nlows_per_high, LO nlows);
 
+/* Given the upward adjacency of a mesh before a rebuild, derive
+   the upward adjacency of the rebuilt mesh.
+   Entities which stayed the same are given by (old_lows2new_lows)
+   and (old_highs2new_highs), which are -1 for removed entities,
+   and the downward adjacency of newly produced high entities
+   is (prods2new_lows).
+   Only the produced entities are inverted, and the result is
+   the same as that of invert_adj() on the new downward adjacency */
+Adj update_up_adj(Adj old_l2h, LOs old_lows2new_lows, LOs old_highs2new_highs,
+    LO nnew_lows, Adj prods2new_lows, LOs prods2new_highs, Int nlows_per_high);
+
 /* given the vertex lists for high entities,
    create vertex lists for all uses of low
    entities by high entities */
 LOs form_uses(LOs hv2v, Omega_h_Family family, Int high_dim, Int low_dim);
 
-LOs find_unique(LOs hv2v, Omega_h_Family family, Int high_dim, Int low_dim);
+/* how find_unique identifies uses of the same low entity.
+   DEDUP_BY_SORTING sorts the canonical vertex lists of all uses.
+   DEDUP_BY_HASHING inserts them into a concurrent hash table,
+   which is expected O(n), and then only sorts the unique entities.
+   both give identical results. */
+enum DedupMethod { DEDUP_BY_SORTING, DEDUP_BY_HASHING };
+
+LOs find_unique(LOs hv2v, Omega_h_Family family, Int high_dim, Int low_dim,
+    DedupMethod method = DEDUP_BY_SORTING);
 
 /* for each entity (or entity use), sort its vertex list
    and express the sorting transformation as an alignment code */
@@ -61,6 +80,19 @@ template <typename T>
 void find_matches_ex(Int deg, LOs a2fv, Read<T> av2v, Read<T> bv2v, Adj v2b,
     LOs* a2b_out, Read<I8>* codes_out, bool allow_duplicates = false);
 
+/* same as find_matches_ex, but finds matches through a hash table
+   of the (b) entities' vertex lists instead of the vertex-to-(b)
+   upward adjacency. with allow_duplicates, an (a) entity is
+   matched to the largest index among identical (b) entities,
+   while find_matches_ex may match it to any of them. */
+template <typename T>
+void find_matches_by_hashing_ex(Int deg, Read<T> av2v, Read<T> bv2v,
+    LOs* a2b_out, Read<I8>* codes_out, bool allow_duplicates = false);
+
+/* same as reflect_down, but without needing the upward adjacency */
+Adj reflect_down_by_hashing(LOs hv2v, LOs lv2v, Omega_h_Family family,
+    Int high_dim, Int low_dim);
+
 /* for testing only, internally computes upward
    adjacency */
 Adj reflect_down(LOs hv2v, LOs lv2v, Omega_h_Family family, LO nv, Int high_dim,
@@ -115,7 +147,9 @@ OMEGA_H_DEVICE Few<Matrix<dim, dim>, neev> gather_symms(
 #define INST_DECL(T)                                                           \
   extern template Read<I8> get_codes_to_canonical(Int deg, Read<T> ev2v);      \
   extern template void find_matches_ex(Int deg, LOs a2fv, Read<T> av2v,        \
-      Read<T> bv2v, Adj v2b, LOs* a2b_out, Read<I8>* codes_out, bool);
+      Read<T> bv2v, Adj v2b, LOs* a2b_out, Read<I8>* codes_out, bool);         \
+  extern template void find_matches_by_hashing_ex(Int deg, Read<T> av2v,       \
+      Read<T> bv2v, LOs* a2b_out, Read<I8>* codes_out, bool);
 INST_DECL(LO)
 INST_DECL(GO)
 #undef INST_DECL
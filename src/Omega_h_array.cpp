@@ -6,6 +6,7 @@
 #include "Omega_h_control.hpp"
 #include "Omega_h_functors.hpp"
 #include "Omega_h_loop.hpp"
+#include "Omega_h_pool.hpp"
 
 namespace Omega_h {
 
@@ -51,11 +52,25 @@ void Write<T>::log_allocation() const {
   }
 }
 
+#ifndef OMEGA_H_USE_KOKKOSCORE
+template <typename T>
+struct PoolDeleter {
+  std::size_t capacity;
+  void operator()(T* p) const { pool_deallocate(p, capacity); }
+};
+#endif
+
 #ifdef OMEGA_H_USE_KOKKOSCORE
 template <typename T>
 Write<T>::Write(Kokkos::View<T*> view_in) : view_(view_in) {
   log_allocation();
 }
+#else
+template <typename T>
+Write<T>::Write(std::shared_ptr<T> ptr_in, LO size_in)
+    : ptr_(ptr_in), size_(size_in) {
+  log_allocation();
+}
 #endif
 
 template <typename T>
@@ -66,7 +81,9 @@ Write<T>::Write(LO size_in, std::string const& name) {
       static_cast<std::size_t>(size_in));
 #else
   (void)name;
-  ptr_ = decltype(ptr_)(new T[size_in], std::default_delete<T[]>());
+  auto capacity = static_cast<std::size_t>(size_in) * sizeof(T);
+  auto p = static_cast<T*>(pool_allocate(&capacity));
+  ptr_ = decltype(ptr_)(p, PoolDeleter<T>{capacity});
   size_ = size_in;
 #endif
   log_allocation();
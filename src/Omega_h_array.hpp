@@ -27,6 +27,9 @@ class Write {
   OMEGA_H_INLINE Write();
 #ifdef OMEGA_H_USE_KOKKOSCORE
   Write(Kokkos::View<T*> view_in);
+#else
+  /* uses memory owned elsewhere, which (ptr_in) keeps alive */
+  Write(std::shared_ptr<T> ptr_in, LO size_in);
 #endif
   Write(LO size_in, std::string const& name = "");
   Write(LO size_in, T value, std::string const& name = "");
@@ -21,6 +21,37 @@ struct Atomics<true> {
   static OMEGA_H_INLINE T fetch_add(volatile T* const dest, const T val) {
     return Kokkos::atomic_fetch_add(dest, val);
   }
+  template <typename T>
+  static OMEGA_H_INLINE T compare_exchange(
+      volatile T* const dest, const T compare, const T val) {
+    return Kokkos::atomic_compare_exchange(dest, compare, val);
+  }
+};
+#elif defined(OMEGA_H_USE_OPENMP)
+/* the OpenMP backend of Omega_h_loop.hpp runs kernels on threads
+   without Kokkos, so use the GCC-style builtins that OpenMP compilers
+   provide. only integer types are used with these. */
+template <>
+struct Atomics<true> {
+  template <typename T>
+  static inline void increment(volatile T* const dest) {
+    __atomic_fetch_add(dest, T(1), __ATOMIC_RELAXED);
+  }
+  template <typename T>
+  static inline void add(volatile T* const dest, const T val) {
+    __atomic_fetch_add(dest, val, __ATOMIC_RELAXED);
+  }
+  template <typename T>
+  static inline T fetch_add(volatile T* const dest, const T val) {
+    return __atomic_fetch_add(dest, val, __ATOMIC_RELAXED);
+  }
+  template <typename T>
+  static inline T compare_exchange(
+      volatile T* const dest, T compare, const T val) {
+    __atomic_compare_exchange_n(
+        dest, &compare, val, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    return compare;
+  }
 };
 #endif
 
@@ -40,11 +71,20 @@ struct Atomics<false> {
     *dest += val;
     return tmp;
   }
+  template <typename T>
+  static OMEGA_H_INLINE T compare_exchange(
+      volatile T* const dest, const T compare, const T val) {
+    T tmp = *dest;
+    if (tmp == compare) *dest = val;
+    return tmp;
+  }
 };
 
 #ifdef OMEGA_H_USE_KOKKOSCORE
 constexpr bool enable_atomics =
     !std::is_same<Kokkos::DefaultExecutionSpace, Kokkos::Serial>::value;
+#elif defined(OMEGA_H_USE_OPENMP)
+constexpr bool enable_atomics = true;
 #else
 constexpr bool enable_atomics = false;
 #endif
@@ -64,6 +104,14 @@ OMEGA_H_INLINE T atomic_fetch_add(volatile T* const dest, const T val) {
   return Atomics<enable_atomics>::fetch_add<T>(dest, val);
 }
 
+/* if (*dest == compare), sets (*dest = val).
+   either way, returns the old value of (*dest) */
+template <typename T>
+OMEGA_H_INLINE T atomic_compare_exchange(
+    volatile T* const dest, const T compare, const T val) {
+  return Atomics<enable_atomics>::compare_exchange<T>(dest, compare, val);
+}
+
 }  // end namespace Omega_h
 
 #endif
@@ -68,7 +68,8 @@ void build_ents_from_elems2verts(
   auto comm = mesh->comm();
   auto elem_dim = mesh->dim();
   for (Int mdim = 1; mdim < elem_dim; ++mdim) {
-    auto mv2v = find_unique(ev2v, mesh->family(), elem_dim, mdim);
+    auto mv2v =
+        find_unique(ev2v, mesh->family(), elem_dim, mdim, DEDUP_BY_HASHING);
     add_ents2verts(mesh, mdim, mv2v, vert_globals, elem_globals);
   }
   add_ents2verts(mesh, elem_dim, ev2v, vert_globals, elem_globals);
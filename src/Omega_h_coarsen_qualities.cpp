@@ -57,7 +57,7 @@ static Reals coarsen_qualities_tmpl(
       qualities[cand * 2 + eev_col] = minqual;
     }
   };
-  parallel_for(ncands, f, "coarsen_qualities");
+  parallel_for_dynamic(ncands, f, "coarsen_qualities");
   auto out = Reals(qualities);
   return mesh->sync_subset_array(EDGE, out, cands2edges, -1.0, 2);
 }
@@ -2,6 +2,13 @@
 
 #include <string>
 
+#ifndef OMEGA_H_USE_MPI
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_scan.hpp"
 
@@ -18,9 +25,147 @@ namespace Omega_h {
 #define CALL(f) OMEGA_H_CHECK(MPI_SUCCESS == (f))
 #endif
 
+#ifndef OMEGA_H_USE_MPI
+
+/* the state shared by the ranks of a Comm whose ranks are threads.
+   a collective operation has every rank post a pointer to its
+   contribution in (slots) and wait at a barrier, after which any
+   rank may read any contribution */
+struct CommThreads {
+  explicit CommThreads(I32 size_in);
+  void barrier();
+  I32 size;
+  std::mutex mutex;
+  std::condition_variable cv;
+  I32 nwaiting;
+  std::size_t generation;
+  std::vector<void const*> slots;
+};
+
+CommThreads::CommThreads(I32 size_in)
+    : size(size_in),
+      nwaiting(0),
+      generation(0),
+      slots(std::size_t(size_in), nullptr) {}
+
+void CommThreads::barrier() {
+  std::unique_lock<std::mutex> lock(mutex);
+  auto my_generation = generation;
+  if (++nwaiting == size) {
+    nwaiting = 0;
+    ++generation;
+    cv.notify_all();
+    return;
+  }
+  cv.wait(lock, [&]() { return generation != my_generation; });
+}
+
+/* returns every rank's (value), indexed by rank.
+   the second barrier keeps each rank's (value) alive and its slot
+   unchanged until all ranks have copied it */
+template <typename T>
+static std::vector<T> gather_threads(
+    CommThreads* threads, I32 rank, T const& value) {
+  threads->slots[std::size_t(rank)] = &value;
+  threads->barrier();
+  std::vector<T> values;
+  values.reserve(threads->slots.size());
+  for (auto slot : threads->slots) {
+    values.push_back(*static_cast<T const*>(slot));
+  }
+  threads->barrier();
+  return values;
+}
+
+/* rank 0 creates the shared state of a new communicator
+   among the same threads */
+static std::shared_ptr<CommThreads> new_threads(
+    CommThreads* threads, I32 rank) {
+  std::shared_ptr<CommThreads> created;
+  if (rank == 0) created = std::make_shared<CommThreads>(threads->size);
+  return gather_threads(threads, rank, created)[0];
+}
+
+/* since ranks may list a neighbor more than once, the (k)th
+   incoming edge from a rank is matched with the (k)th outgoing
+   edge of that rank which goes to this one */
+static LO find_thread_edge(HostRead<I32> src_dsts, I32 dst, LO k) {
+  for (LO i = 0; i < src_dsts.size(); ++i) {
+    if (src_dsts[i] == dst && k-- == 0) return i;
+  }
+  Omega_h_fail("no matching message edge to rank %d\n", dst);
+}
+
+static LO count_before(HostRead<I32> ranks, LO i) {
+  LO k = 0;
+  for (LO j = 0; j < i; ++j) k += (ranks[j] == ranks[i]);
+  return k;
+}
+
+template <typename T>
+static T combine(T a, T b, Omega_h_Op op) {
+  switch (op) {
+    case OMEGA_H_MIN:
+      return std::min(a, b);
+    case OMEGA_H_MAX:
+      return std::max(a, b);
+    case OMEGA_H_SUM:
+      return a + b;
+  }
+  OMEGA_H_NORETURN(a);
+}
+
+template <typename T>
+struct ThreadMessage {
+  HostRead<I32> dsts;
+  HostRead<LO> sdispls;
+  HostRead<T> data;
+};
+
+template <typename T>
+static Read<T> thread_alltoallv(CommThreads* threads, I32 rank,
+    HostRead<I32> srcs, HostRead<I32> dsts, Read<T> sendbuf,
+    Read<LO> sdispls, Read<LO> rdispls_dev, Int width) {
+  ThreadMessage<T> message;
+  message.dsts = dsts;
+  message.sdispls = HostRead<LO>(sdispls);
+  message.data = HostRead<T>(sendbuf);
+  OMEGA_H_CHECK(sendbuf.size() == message.sdispls.last() * width);
+  auto messages = gather_threads(threads, rank, message);
+  HostRead<LO> rdispls(rdispls_dev);
+  HostWrite<T> recvbuf(rdispls.last() * width);
+  for (LO i = 0; i < srcs.size(); ++i) {
+    auto const& from = messages[std::size_t(srcs[i])];
+    auto edge = find_thread_edge(from.dsts, rank, count_before(srcs, i));
+    auto begin = from.sdispls[edge] * width;
+    auto end = from.sdispls[edge + 1] * width;
+    auto offset = rdispls[i] * width;
+    OMEGA_H_CHECK(end - begin == rdispls[i + 1] * width - offset);
+    for (LO j = begin; j < end; ++j) recvbuf[offset + j - begin] = from.data[j];
+  }
+  return recvbuf.write();
+}
+
+void run_comm_threads(
+    Library* library, I32 nranks, std::function<void(CommPtr)> const& f) {
+  OMEGA_H_CHECK(nranks > 0);
+  auto threads = std::make_shared<CommThreads>(nranks);
+  std::vector<std::thread> workers;
+  for (I32 rank = 0; rank < nranks; ++rank) {
+    auto comm =
+        CommPtr(new Comm(library, threads, rank, Read<I32>(), Read<I32>()));
+    workers.emplace_back(f, comm);
+  }
+  for (auto& worker : workers) worker.join();
+}
+
+#endif
+
 Comm::Comm() {
 #ifdef OMEGA_H_USE_MPI
   impl_ = MPI_COMM_NULL;
+#else
+  thread_rank_ = 0;
 #endif
   library_ = nullptr;
 }
@@ -48,7 +193,7 @@ Comm::Comm(Library* library_in, MPI_Comm impl_in)
 }
 #else
 Comm::Comm(Library* library_in, bool is_graph, bool sends_to_self)
-    : library_(library_in) {
+    : thread_rank_(0), library_(library_in) {
   if (is_graph) {
     if (sends_to_self) {
       srcs_ = Read<LO>({0});
@@ -64,6 +209,19 @@ Comm::Comm(Library* library_in, bool is_graph, bool sends_to_self)
     OMEGA_H_CHECK(!sends_to_self);
   }
 }
+
+Comm::Comm(Library* library_in, std::shared_ptr<CommThreads> threads,
+    I32 rank_in, Read<I32> srcs, Read<I32> dsts)
+    : threads_(threads), thread_rank_(rank_in), library_(library_in) {
+  if (dsts.exists()) {
+    srcs_ = srcs;
+    dsts_ = dsts;
+    self_src_ = find_last(srcs_, rank_in);
+    self_dst_ = find_last(dsts_, rank_in);
+    host_srcs_ = HostRead<I32>(srcs_);
+    host_dsts_ = HostRead<I32>(dsts_);
+  }
+}
 #endif
 
 Comm::~Comm() {
@@ -80,7 +238,7 @@ I32 Comm::rank() const {
   CALL(MPI_Comm_rank(impl_, &r));
   return r;
 #else
-  return 0;
+  return thread_rank_;
 #endif
 }
 
@@ -90,7 +248,7 @@ I32 Comm::size() const {
   CALL(MPI_Comm_size(impl_, &s));
   return s;
 #else
-  return 1;
+  return threads_ ? threads_->size : 1;
 #endif
 }
 
@@ -100,6 +258,10 @@ CommPtr Comm::dup() const {
   CALL(MPI_Comm_dup(impl_, &impl2));
   return CommPtr(new Comm(library_, impl2));
 #else
+  if (threads_) {
+    auto threads2 = new_threads(threads_.get(), thread_rank_);
+    return CommPtr(new Comm(library_, threads2, thread_rank_, srcs_, dsts_));
+  }
   return CommPtr(
       new Comm(library_, srcs_.exists(), srcs_.exists() && srcs_.size() == 1));
 #endif
@@ -111,6 +273,27 @@ CommPtr Comm::split(I32 color, I32 key) const {
   CALL(MPI_Comm_split(impl_, color, key, &impl2));
   return CommPtr(new Comm(library_, impl2));
 #else
+  if (threads_) {
+    auto colors_keys = gather_threads(
+        threads_.get(), thread_rank_, std::make_pair(color, key));
+    std::vector<std::pair<I32, I32>> keys_ranks;
+    for (I32 r = 0; r < threads_->size; ++r) {
+      auto color_key = colors_keys[std::size_t(r)];
+      if (color_key.first != color) continue;
+      keys_ranks.push_back(std::make_pair(color_key.second, r));
+    }
+    std::sort(keys_ranks.begin(), keys_ranks.end());
+    I32 rank2 = 0;
+    while (keys_ranks[std::size_t(rank2)].second != thread_rank_) ++rank2;
+    std::shared_ptr<CommThreads> created;
+    if (rank2 == 0) {
+      created = std::make_shared<CommThreads>(I32(keys_ranks.size()));
+    }
+    auto leader = keys_ranks[0].second;
+    auto threads2 = gather_threads(threads_.get(), thread_rank_, created);
+    return CommPtr(new Comm(library_, threads2[std::size_t(leader)], rank2,
+        Read<I32>(), Read<I32>()));
+  }
   (void)color;
   (void)key;
   return CommPtr(new Comm(library_, false, false));
@@ -130,6 +313,22 @@ CommPtr Comm::graph(Read<I32> dsts) const {
       reorder, &impl2));
   return CommPtr(new Comm(library_, impl2));
 #else
+  if (threads_) {
+    auto all_dsts =
+        gather_threads(threads_.get(), thread_rank_, HostRead<I32>(dsts));
+    std::vector<I32> h_srcs;
+    for (I32 r = 0; r < threads_->size; ++r) {
+      auto r_dsts = all_dsts[std::size_t(r)];
+      for (LO i = 0; i < r_dsts.size(); ++i) {
+        if (r_dsts[i] == thread_rank_) h_srcs.push_back(r);
+      }
+    }
+    HostWrite<I32> srcs(LO(h_srcs.size()));
+    for (LO i = 0; i < srcs.size(); ++i) srcs[i] = h_srcs[std::size_t(i)];
+    auto threads2 = new_threads(threads_.get(), thread_rank_);
+    return CommPtr(
+        new Comm(library_, threads2, thread_rank_, srcs.write(), dsts));
+  }
   return CommPtr(new Comm(library_, true, dsts.size() == 1));
 #endif
 }
@@ -146,6 +345,10 @@ CommPtr Comm::graph_adjacent(Read<I32> srcs, Read<I32> dsts) const {
       reorder, &impl2));
   return CommPtr(new Comm(library_, impl2));
 #else
+  if (threads_) {
+    auto threads2 = new_threads(threads_.get(), thread_rank_);
+    return CommPtr(new Comm(library_, threads2, thread_rank_, srcs, dsts));
+  }
   OMEGA_H_CHECK(srcs == dsts);
   return CommPtr(new Comm(library_, true, dsts.size() == 1));
 #endif
@@ -165,11 +368,43 @@ T Comm::allreduce(T x, Omega_h_Op op) const {
   CALL(MPI_Allreduce(
       MPI_IN_PLACE, &x, 1, MpiTraits<T>::datatype(), mpi_op(op), impl_));
 #else
-  (void)op;
+  if (threads_) {
+    auto values = gather_threads(threads_.get(), thread_rank_, x);
+    x = values[0];
+    for (std::size_t r = 1; r < values.size(); ++r) {
+      x = combine(x, values[r], op);
+    }
+  }
 #endif
   return x;
 }
 
+template <typename T>
+Read<T> Comm::allreduce(Read<T> x, Omega_h_Op op) const {
+#ifdef OMEGA_H_USE_MPI
+  HostRead<T> h_x(x);
+  HostWrite<T> h_y(x.size());
+  CALL(MPI_Allreduce(nonnull(h_x.data()), nonnull(h_y.data()), x.size(),
+      MpiTraits<T>::datatype(), mpi_op(op), impl_));
+  return h_y.write();
+#else
+  if (threads_) {
+    auto values = gather_threads(threads_.get(), thread_rank_, HostRead<T>(x));
+    HostWrite<T> h_y(x.size());
+    for (LO i = 0; i < h_y.size(); ++i) {
+      auto y = values[0][i];
+      for (std::size_t r = 1; r < values.size(); ++r) {
+        y = combine(y, values[r][i], op);
+      }
+      h_y[i] = y;
+    }
+    return h_y.write();
+  }
+  (void)op;
+  return x;
+#endif
+}
+
 bool Comm::reduce_or(bool x) const {
   I8 y = x;
   y = allreduce(y, OMEGA_H_MAX);
@@ -197,6 +432,12 @@ Int128 Comm::add_int128(Int128 x) const {
   CALL(MPI_Op_create(mpi_add_int128, commute, &op));
   CALL(MPI_Allreduce(MPI_IN_PLACE, &x, sizeof(Int128), MPI_PACKED, op, impl_));
   CALL(MPI_Op_free(&op));
+#else
+  if (threads_) {
+    auto values = gather_threads(threads_.get(), thread_rank_, x);
+    x = values[0];
+    for (std::size_t r = 1; r < values.size(); ++r) x = x + values[r];
+  }
 #endif
   return x;
 }
@@ -209,6 +450,15 @@ T Comm::exscan(T x, Omega_h_Op op) const {
   if (rank() == 0) x = 0;
   return x;
 #else
+  if (threads_) {
+    auto values = gather_threads(threads_.get(), thread_rank_, x);
+    if (thread_rank_ == 0) return 0;
+    x = values[0];
+    for (I32 r = 1; r < thread_rank_; ++r) {
+      x = combine(x, values[std::size_t(r)], op);
+    }
+    return x;
+  }
   (void)op;
   (void)x;
   return 0;
@@ -220,7 +470,7 @@ void Comm::bcast(T& x) const {
 #ifdef OMEGA_H_USE_MPI
   CALL(MPI_Bcast(&x, 1, MpiTraits<T>::datatype(), 0, impl_));
 #else
-  (void)x;
+  if (threads_) x = gather_threads(threads_.get(), thread_rank_, x)[0];
 #endif
 }
 
@@ -231,7 +481,7 @@ void Comm::bcast_string(std::string& s) const {
   s.resize(static_cast<std::size_t>(len));
   CALL(MPI_Bcast(&s[0], len, MPI_CHAR, 0, impl_));
 #else
-  (void)s;
+  if (threads_) s = gather_threads(threads_.get(), thread_rank_, s)[0];
 #endif
 }
 
@@ -348,8 +598,79 @@ static int Neighbor_alltoallv(HostRead<I32> sources, HostRead<I32> destinations,
   return MPI_SUCCESS;
 }
 
+/* the first half of Neighbor_alltoallv(): all messages are posted
+ * and their requests are appended to (requests)
+ */
+
+static int Ineighbor_alltoallv(HostRead<I32> sources,
+    HostRead<I32> destinations, int width, const void* sendbuf,
+    const int sdispls[], MPI_Datatype sendtype, void* recvbuf,
+    const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm,
+    std::vector<MPI_Request>* requests) {
+  int const tag = 42;
+  int indegree, outdegree;
+  indegree = sources.size();
+  outdegree = destinations.size();
+  int sendwidth;
+  CALL(MPI_Type_size(sendtype, &sendwidth));
+  int recvwidth;
+  CALL(MPI_Type_size(sendtype, &recvwidth));
+  requests->resize(std::size_t(indegree + outdegree));
+  for (int i = 0; i < indegree; ++i) {
+    CALL(MPI_Irecv(static_cast<char*>(recvbuf) + rdispls[i] * recvwidth * width,
+        (rdispls[i + 1] - rdispls[i]) * width, recvtype, sources[i], tag, comm,
+        requests->data() + i));
+  }
+  for (int i = 0; i < outdegree; ++i) {
+    CALL(MPI_Isend(
+        static_cast<char const*>(sendbuf) + sdispls[i] * sendwidth * width,
+        (sdispls[i + 1] - sdispls[i]) * width, sendtype, destinations[i], tag,
+        comm, requests->data() + indegree + i));
+  }
+  return MPI_SUCCESS;
+}
+
 #endif  // end ifdef OMEGA_H_USE_MPI
 
+template <typename T>
+struct CommRequest<T>::State {
+  Read<T> result;
+#ifdef OMEGA_H_USE_MPI
+  Read<T> sendbuf;
+  std::vector<MPI_Request> requests;
+  void complete() {
+    if (requests.empty()) return;
+    CALL(MPI_Waitall(
+        int(requests.size()), requests.data(), MPI_STATUSES_IGNORE));
+    requests.clear();
+    sendbuf = Read<T>();
+  }
+  ~State() { complete(); }
+#endif
+};
+
+template <typename T>
+CommRequest<T>::CommRequest() {}
+
+template <typename T>
+CommRequest<T>::CommRequest(Read<T> result)
+    : state_(std::make_shared<State>()) {
+  state_->result = result;
+}
+
+template <typename T>
+Read<T> CommRequest<T>::wait() {
+  if (!state_) return Read<T>();
+#ifdef OMEGA_H_USE_MPI
+  if (!state_->requests.empty()) {
+    begin_code("CommRequest::wait");
+    state_->complete();
+    end_code();
+  }
+#endif
+  return state_->result;
+}
+
 template <typename T>
 Read<T> Comm::allgather(T x) const {
 #ifdef OMEGA_H_USE_MPI
@@ -359,6 +680,14 @@ Read<T> Comm::allgather(T x) const {
       MpiTraits<T>::datatype(), impl_));
   return recvbuf.write();
 #else
+  if (threads_) {
+    auto values = gather_threads(threads_.get(), thread_rank_, x);
+    HostWrite<T> recvbuf(srcs_.size());
+    for (LO i = 0; i < recvbuf.size(); ++i) {
+      recvbuf[i] = values[std::size_t(host_srcs_[i])];
+    }
+    return recvbuf.write();
+  }
   if (srcs_.size() == 1) return Read<T>({x});
   return Read<T>({});
 #endif
@@ -374,6 +703,10 @@ Read<T> Comm::alltoall(Read<T> x) const {
       MpiTraits<T>::datatype(), impl_));
   return recvbuf.write();
 #else
+  if (threads_) {
+    return alltoallv(
+        x, LOs(dsts_.size() + 1, 0, 1), LOs(srcs_.size() + 1, 0, 1), 1);
+  }
   return x;
 #endif
 }
@@ -489,30 +822,67 @@ Read<T> Comm::alltoallv(Read<T> sendbuf_dev, Read<LO> sdispls_dev,
   Read<T> recvbuf_dev = recvbuf_dev_w;
 #endif  // !defined(OMEGA_H_USE_CUDA) || defined(OMEGA_H_USE_CUDA_AWARE_MPI)
 #else   // !defined(OMEGA_H_USE_MPI)
-  (void)sdispls_dev;
-  (void)rdispls_dev;
-  (void)width;
-  auto recvbuf_dev = sendbuf_dev;
+  Read<T> recvbuf_dev;
+  if (threads_) {
+    recvbuf_dev = thread_alltoallv(threads_.get(), thread_rank_, host_srcs_,
+        host_dsts_, sendbuf_dev, sdispls_dev, rdispls_dev, width);
+  } else {
+    recvbuf_dev = sendbuf_dev;
+  }
 #endif  // !defined(OMEGA_H_USE_MPI)
   end_code();
   return recvbuf_dev;
 }
 
+template <typename T>
+CommRequest<T> Comm::ialltoallv(Read<T> sendbuf_dev, Read<LO> sdispls_dev,
+    Read<LO> rdispls_dev, Int width) const {
+#if defined(OMEGA_H_USE_MPI) &&                                               \
+    (!defined(OMEGA_H_USE_CUDA) || defined(OMEGA_H_USE_CUDA_AWARE_MPI))
+  begin_code("Comm::ialltoallv");
+  HostRead<LO> sdispls(sdispls_dev);
+  HostRead<LO> rdispls(rdispls_dev);
+  OMEGA_H_CHECK(sendbuf_dev.size() == sdispls.last() * width);
+  Write<T> recvbuf_dev_w(rdispls.last() * width);
+  CommRequest<T> request{Read<T>(recvbuf_dev_w)};
+  request.state_->sendbuf = sendbuf_dev;
+  CALL(Ineighbor_alltoallv(host_srcs_, host_dsts_, width,
+      nonnull(sendbuf_dev.data()), nonnull(sdispls.data()),
+      MpiTraits<T>::datatype(), nonnull(recvbuf_dev_w.data()),
+      nonnull(rdispls.data()), MpiTraits<T>::datatype(), impl_,
+      &request.state_->requests));
+  end_code();
+  return request;
+#else
+  /* without MPI there is nothing to wait for, and staging through
+     host memory for MPI that is not CUDA-aware has to finish
+     before the device can see the data */
+  auto recvbuf_dev = alltoallv(sendbuf_dev, sdispls_dev, rdispls_dev, width);
+  return CommRequest<T>(recvbuf_dev);
+#endif
+}
+
 void Comm::barrier() const {
 #ifdef OMEGA_H_USE_MPI
   CALL(MPI_Barrier(impl_));
+#else
+  if (threads_) threads_->barrier();
 #endif
 }
 
 #undef CALL
 
 #define INST(T)                                                                \
+  template class CommRequest<T>;                                               \
   template T Comm::allreduce(T x, Omega_h_Op op) const;                        \
+  template Read<T> Comm::allreduce(Read<T> x, Omega_h_Op op) const;            \
   template T Comm::exscan(T x, Omega_h_Op op) const;                           \
   template void Comm::bcast(T& x) const;                                       \
   template Read<T> Comm::allgather(T x) const;                                 \
   template Read<T> Comm::alltoall(Read<T> x) const;                            \
   template Read<T> Comm::alltoallv(                                            \
+      Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
+  template CommRequest<T> Comm::ialltoallv(                                    \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
 INST(I8)
 INST(I32)
@@ -1,7 +1,9 @@
 #ifndef OMEGA_H_COMM_HPP
 #define OMEGA_H_COMM_HPP
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include <Omega_h_c.h>
 #include <Omega_h_array.hpp>
@@ -14,12 +16,36 @@ static_assert(sizeof(int) == 4, "Omega_h::Comm assumes 32-bit int");
 
 class Library;
 class Comm;
+#ifndef OMEGA_H_USE_MPI
+struct CommThreads;
+#endif
 
 typedef std::shared_ptr<Comm> CommPtr;
 
+/* an exchange started by Comm::ialltoallv().
+   wait() blocks until the received data is complete and returns it.
+   copies share the same exchange, and waiting more than once
+   just returns the same data. if no copy waits, the last one
+   to be destroyed waits, so the buffers outlive the messages */
+template <typename T>
+class CommRequest {
+ public:
+  CommRequest();
+  explicit CommRequest(Read<T> result);
+  Read<T> wait();
+
+ private:
+  friend class Comm;
+  struct State;
+  std::shared_ptr<State> state_;
+};
+
 class Comm {
 #ifdef OMEGA_H_USE_MPI
   MPI_Comm impl_;
+#else
+  std::shared_ptr<CommThreads> threads_;
+  I32 thread_rank_;
 #endif
   Library* library_;
   Read<I32> srcs_;
@@ -36,6 +62,8 @@ class Comm {
   MPI_Comm get_impl() const { return impl_; }
 #else
   Comm(Library* library, bool is_graph, bool sends_to_self);
+  Comm(Library* library, std::shared_ptr<CommThreads> threads, I32 rank,
+      Read<I32> srcs, Read<I32> dsts);
 #endif
   ~Comm();
   Library* library() const;
@@ -50,6 +78,9 @@ class Comm {
   Read<I32> destinations() const;
   template <typename T>
   T allreduce(T x, Omega_h_Op op) const;
+  /* reduces each entry separately, in a single message */
+  template <typename T>
+  Read<T> allreduce(Read<T> x, Omega_h_Op op) const;
   bool reduce_or(bool x) const;
   bool reduce_and(bool x) const;
   Int128 add_int128(Int128 x) const;
@@ -65,9 +96,24 @@ class Comm {
   template <typename T>
   Read<T> alltoallv(
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
+  /* the non-blocking version of alltoallv(): messages are posted
+     and the call returns, so local work can overlap their latency */
+  template <typename T>
+  CommRequest<T> ialltoallv(
+      Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
   void barrier() const;
 };
 
+#ifndef OMEGA_H_USE_MPI
+/* runs f(comm) on (nranks) threads of this process, where each
+   comm is one rank of a communicator of size (nranks).
+   messages go through shared memory, so distributed code paths
+   can be tested and timed without an MPI install.
+   returns once all threads have returned */
+void run_comm_threads(
+    Library* library, I32 nranks, std::function<void(CommPtr)> const& f);
+#endif
+
 #ifdef OMEGA_H_USE_MPI
 
 #ifdef OMPI_MPI_H
@@ -132,12 +178,16 @@ inline MPI_Op mpi_op(Omega_h_Op op) {
 #endif
 
 #define OMEGA_H_EXPL_INST_DECL(T)                                              \
+  extern template class CommRequest<T>;                                        \
   extern template T Comm::allreduce(T x, Omega_h_Op op) const;                 \
+  extern template Read<T> Comm::allreduce(Read<T> x, Omega_h_Op op) const;     \
   extern template T Comm::exscan(T x, Omega_h_Op op) const;                    \
   extern template void Comm::bcast(T& x) const;                                \
   extern template Read<T> Comm::allgather(T x) const;                          \
   extern template Read<T> Comm::alltoall(Read<T> x) const;                     \
   extern template Read<T> Comm::alltoallv(                                     \
+      Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
+  extern template CommRequest<T> Comm::ialltoallv(                             \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
 OMEGA_H_EXPL_INST_DECL(I8)
 OMEGA_H_EXPL_INST_DECL(I32)
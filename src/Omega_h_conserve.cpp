@@ -87,7 +87,7 @@ static SeparationResult separate_by_color_once(
       new_keep_w[kn] = (new_elem_colors[elem] == color);
     }
   };
-  parallel_for(nkeys, f, "separate_by_color");
+  parallel_for_dynamic(nkeys, f, "separate_by_color");
   auto old_keep = Read<I8>(old_keep_w);
   auto new_keep = Read<I8>(new_keep_w);
   auto separated_old = filter_graph(keys2old, old_keep);
@@ -448,7 +448,7 @@ static void transfer_by_intersection_dim(Mesh* old_mesh, Mesh* new_mesh,
       }
     }  // end loop over new elements
   };
-  parallel_for(nkeys, f, "transfer_by_intersection");
+  parallel_for_dynamic(nkeys, f, "transfer_by_intersection");
 }
 
 static void transfer_by_intersection(Mesh* old_mesh, Mesh* new_mesh,
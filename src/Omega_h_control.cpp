@@ -11,6 +11,7 @@
 
 #include "Omega_h_cmdline.hpp"
 #include "Omega_h_library.hpp"
+#include "Omega_h_pool.hpp"
 
 namespace Omega_h {
 
@@ -167,6 +168,7 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
       "--osh-time", "print amount of time spend in certain functions");
   cmdline.add_flag("--osh-signal", "catch signals and print a stacktrace");
   cmdline.add_flag("--osh-silent", "suppress all output");
+  cmdline.add_flag("--osh-pool", "cache and reuse array memory");
   auto& self_send_flag =
       cmdline.add_flag("--osh-self-send", "control self send threshold");
   self_send_flag.add_arg<int>("value");
@@ -181,6 +183,7 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
     self_send_threshold_ = cmdline.get<int>("--osh-self-send", "value");
   }
   silent_ = cmdline.parsed("--osh-silent");
+  if (cmdline.parsed("--osh-pool")) enable_pooling();
 #ifdef OMEGA_H_USE_KOKKOSCORE
   if (!Kokkos::is_initialized()) {
     OMEGA_H_CHECK(argc != nullptr);
@@ -229,6 +232,15 @@ Library::~Library() {
       }
     }
   }
+  if (is_pooling_enabled()) {
+    auto hits = world_->allreduce(I64(get_pool_hits()), OMEGA_H_SUM);
+    auto misses = world_->allreduce(I64(get_pool_misses()), OMEGA_H_SUM);
+    if (!silent_ && world_->rank() == 0) {
+      std::cout << "Omega_h memory pool: " << hits << " hits, " << misses
+                << " misses\n";
+    }
+    disable_pooling();
+  }
   // need to destroy all Comm objects prior to MPI_Finalize()
   world_ = CommPtr();
   self_ = CommPtr();
@@ -107,21 +107,54 @@ Dist Dist::invert() const {
   return out;
 }
 
+template <typename T>
+DistRequest<T>::DistRequest() : width_(0) {}
+
+template <typename T>
+DistRequest<T>::DistRequest(Read<T> result)
+    : request_(result), width_(0) {}
+
+template <typename T>
+Read<T> DistRequest<T>::wait() {
+  auto data = request_.wait();
+  if (items2content_.exists()) {
+    data = unmap(items2content_, data, width_);
+    request_ = CommRequest<T>(data);
+    items2content_ = LOs();
+  }
+  return data;
+}
+
 template <typename T>
 Read<T> Dist::exch(Read<T> data, Int width) const {
   begin_code("Dist::exch");
+  auto request = exch_begin(data, width);
+  data = exch_end(request);
+  end_code();
+  return data;
+}
+
+template <typename T>
+DistRequest<T> Dist::exch_begin(Read<T> data, Int width) const {
+  begin_code("Dist::exch_begin");
   if (roots2items_[F].exists()) {
     data = expand(data, roots2items_[F], width);
   }
   if (items2content_[F].exists()) {
     data = permute(data, items2content_[F], width);
   }
-  data = comm_[F]->alltoallv(data, msgs2content_[F], msgs2content_[R], width);
-  if (items2content_[R].exists()) {
-    data = unmap(items2content_[R], data, width);
-  }
+  DistRequest<T> request;
+  request.request_ =
+      comm_[F]->ialltoallv(data, msgs2content_[F], msgs2content_[R], width);
+  request.items2content_ = items2content_[R];
+  request.width_ = width;
   end_code();
-  return data;
+  return request;
+}
+
+template <typename T>
+Read<T> Dist::exch_end(DistRequest<T>& request) const {
+  return request.wait();
 }
 
 template <typename T>
@@ -202,7 +235,10 @@ void Dist::copy(Dist const& other) {
 }
 
 #define INST_T(T)                                                              \
+  template class DistRequest<T>;                                               \
   template Read<T> Dist::exch(Read<T> data, Int width) const;                  \
+  template DistRequest<T> Dist::exch_begin(Read<T> data, Int width) const;     \
+  template Read<T> Dist::exch_end(DistRequest<T> & request) const;             \
   template Read<T> Dist::exch_reduce(Read<T> data, Int width, Omega_h_Op op)   \
       const;
 INST_T(I8)
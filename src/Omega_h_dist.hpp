@@ -79,6 +79,21 @@ namespace Omega_h {
    sent and received data, respectively.
  */
 
+/* an exchange started by Dist::exch_begin(), see CommRequest */
+template <typename T>
+class DistRequest {
+ public:
+  DistRequest();
+  explicit DistRequest(Read<T> result);
+  Read<T> wait();
+
+ private:
+  friend class Dist;
+  CommRequest<T> request_;
+  LOs items2content_;
+  Int width_;
+};
+
 class Dist {
   CommPtr parent_comm_;
   LOs roots2items_[2];
@@ -125,6 +140,13 @@ class Dist {
   Dist invert() const;
   template <typename T>
   Read<T> exch(Read<T> data, Int width) const;
+  /* exch() split in two: exch_begin() sends the data and
+     exch_end() waits for it to arrive, so local work that does
+     not need the result can be done in between */
+  template <typename T>
+  DistRequest<T> exch_begin(Read<T> data, Int width) const;
+  template <typename T>
+  Read<T> exch_end(DistRequest<T>& request) const;
   template <typename T>
   Read<T> exch_reduce(Read<T> data, Int width, Omega_h_Op op) const;
   CommPtr parent_comm() const;
@@ -150,7 +172,11 @@ class Dist {
 };
 
 #define OMEGA_H_EXPL_INST_DECL(T)                                              \
+  extern template class DistRequest<T>;                                        \
   extern template Read<T> Dist::exch(Read<T> data, Int width) const;           \
+  extern template DistRequest<T> Dist::exch_begin(Read<T> data, Int width)     \
+      const;                                                                   \
+  extern template Read<T> Dist::exch_end(DistRequest<T> & request) const;      \
   extern template Read<T> Dist::exch_reduce<T>(                                \
       Read<T> data, Int width, Omega_h_Op op) const;
 OMEGA_H_EXPL_INST_DECL(I8)
@@ -18,7 +18,7 @@ static void form_sharing(Mesh* mesh_osh, Int ent_dim,
   if (!mesh_osh->could_be_shared(ent_dim)) {
     return;
   }
-  auto dist = mesh_osh->ask_dist(ent_dim).invert();
+  auto dist = mesh_osh->ask_inverse_dist(ent_dim);
   auto d_owners2copies = dist.roots2items();
   auto d_copies2rank = dist.items2ranks();
   auto d_copies2indices = dist.items2dest_idxs();
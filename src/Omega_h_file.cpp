@@ -1,20 +1,33 @@
 #include "Omega_h_file.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cerrno>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #ifdef OMEGA_H_USE_ZLIB
 #include <zlib.h>
 #endif
 
+#include "Omega_h_adj.hpp"
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_build.hpp"
+#include "Omega_h_element.hpp"
 #include "Omega_h_inertia.hpp"
 #include "Omega_h_loop.hpp"
+#include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
 
 namespace Omega_h {
@@ -131,6 +144,192 @@ OMEGA_H_INLINE void swap_bytes(T* ptr) {
 
 unsigned char const magic[2] = {0xa1, 0x1a};
 
+/* a whole file mapped into memory. the mapping is private,
+   so changes to arrays in it never reach the file */
+struct FileMapping {
+  char* data;
+  std::size_t size;
+  FileMapping(std::string const& filepath) {
+    auto fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd == -1) {
+      Omega_h_fail("omega_h could not open \"%s\", got error \"%s\"\n",
+          filepath.c_str(), std::strerror(errno));
+    }
+    struct stat info;
+    OMEGA_H_CHECK(::fstat(fd, &info) == 0);
+    size = static_cast<std::size_t>(info.st_size);
+    OMEGA_H_CHECK(size > 0);
+    auto addr = ::mmap(
+        nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      Omega_h_fail("omega_h could not map \"%s\", got error \"%s\"\n",
+          filepath.c_str(), std::strerror(errno));
+    }
+    data = static_cast<char*>(addr);
+  }
+  ~FileMapping() { ::munmap(data, size); }
+  FileMapping(FileMapping const&) = delete;
+  FileMapping& operator=(FileMapping const&) = delete;
+};
+
+/* lets read() go through a mapped file like any stream,
+   while read_array() can take arrays out of it without copying */
+class MappedBuffer : public std::streambuf {
+  std::shared_ptr<FileMapping> mapping_;
+
+ public:
+  MappedBuffer(std::shared_ptr<FileMapping> mapping) : mapping_(mapping) {
+    setg(mapping->data, mapping->data, mapping->data + mapping->size);
+  }
+  template <typename T>
+  bool can_take(LO size) const {
+    auto bytes = static_cast<std::size_t>(size) * sizeof(T);
+    auto addr = reinterpret_cast<std::uintptr_t>(gptr());
+    return (addr % alignof(T) == 0) &&
+           (bytes <= static_cast<std::size_t>(egptr() - gptr()));
+  }
+#ifndef OMEGA_H_USE_KOKKOSCORE
+  template <typename T>
+  Write<T> take(LO size) {
+    auto bytes = static_cast<std::size_t>(size) * sizeof(T);
+    auto p = reinterpret_cast<T*>(gptr());
+    setg(eback(), gptr() + bytes, egptr());
+    return Write<T>(std::shared_ptr<T>(mapping_, p), size);
+  }
+#endif
+
+ protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+      std::ios_base::openmode which) override {
+    if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+    char* from = gptr();
+    if (dir == std::ios_base::beg) from = eback();
+    if (dir == std::ios_base::end) from = egptr();
+    if (off < eback() - from || off > egptr() - from) {
+      return pos_type(off_type(-1));
+    }
+    setg(eback(), from + off, egptr());
+    return pos_type(gptr() - eback());
+  }
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
+/* forwards to another stream buffer and counts the bytes that went
+   through it, so padding still works on streams that cannot tell
+   their position, like pipes. positions count from where the
+   counting started, and forward seeks on input skip bytes */
+class CountingBuffer : public std::streambuf {
+  std::streambuf* target_;
+  std::streamoff count_;
+
+ public:
+  CountingBuffer(std::streambuf* target) : target_(target), count_(0) {}
+
+ protected:
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    auto ret = target_->sputc(traits_type::to_char_type(c));
+    if (!traits_type::eq_int_type(ret, traits_type::eof())) ++count_;
+    return ret;
+  }
+  std::streamsize xsputn(char const* s, std::streamsize n) override {
+    auto ret = target_->sputn(s, n);
+    count_ += ret;
+    return ret;
+  }
+  int_type underflow() override { return target_->sgetc(); }
+  int_type uflow() override {
+    auto ret = target_->sbumpc();
+    if (!traits_type::eq_int_type(ret, traits_type::eof())) ++count_;
+    return ret;
+  }
+  std::streamsize xsgetn(char* s, std::streamsize n) override {
+    auto ret = target_->sgetn(s, n);
+    count_ += ret;
+    return ret;
+  }
+  int sync() override { return target_->pubsync(); }
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+      std::ios_base::openmode which) override {
+    if (dir == std::ios_base::cur) off += count_;
+    if (dir == std::ios_base::end) return pos_type(off_type(-1));
+    if (off == count_) return pos_type(count_);
+    if (off < count_ || (which & std::ios_base::out)) {
+      return pos_type(off_type(-1));
+    }
+    while (count_ < off) {
+      if (traits_type::eq_int_type(uflow(), traits_type::eof())) {
+        return pos_type(off_type(-1));
+      }
+    }
+    return pos_type(count_);
+  }
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
+/* writes into (data) after what it already holds, so a part can be
+   built in a string that is written as it is, without the copy
+   ostringstream::str() makes. positions count from where it started */
+class StringBuffer : public std::streambuf {
+  std::string& data_;
+  std::size_t start_;
+  std::size_t pos_;
+
+ public:
+  StringBuffer(std::string& data)
+      : data_(data), start_(data.size()), pos_(data.size()) {}
+
+ protected:
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    auto ch = traits_type::to_char_type(c);
+    xsputn(&ch, 1);
+    return c;
+  }
+  std::streamsize xsputn(char const* s, std::streamsize n) override {
+    auto count = std::size_t(n);
+    auto overlap = std::min(count, data_.size() - pos_);
+    data_.replace(pos_, overlap, s, overlap);
+    data_.append(s + overlap, count - overlap);
+    pos_ += count;
+    return n;
+  }
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+      std::ios_base::openmode which) override {
+    if (!(which & std::ios_base::out)) return pos_type(off_type(-1));
+    auto from = off_type(pos_ - start_);
+    if (dir == std::ios_base::beg) from = 0;
+    if (dir == std::ios_base::end) from = off_type(data_.size() - start_);
+    auto to = from + off;
+    if (to < 0 || to > off_type(data_.size() - start_)) {
+      return pos_type(off_type(-1));
+    }
+    pos_ = start_ + std::size_t(to);
+    return pos_type(to);
+  }
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
+/* since version 8, uncompressed array data is padded to start
+   at a multiple of its value size from the start of the stream,
+   so arrays in a mapped file can be used in place */
+std::streamoff get_padding(std::streamoff pos, std::size_t alignment) {
+  OMEGA_H_CHECK(pos >= 0);
+  auto a = static_cast<std::streamoff>(alignment);
+  return (a - pos % a) % a;
+}
+
 }  // end anonymous namespace
 
 template <typename T>
@@ -163,42 +362,218 @@ void read_value(std::istream& stream, T& val) {
   swap_if_needed(val);
 }
 
+#ifdef OMEGA_H_USE_ZLIB
+/* since version 9, compressed arrays are split into chunks of
+   this many uncompressed bytes, which are compressed independently
+   and in parallel. the compressed size of every chunk is written
+   before the chunks, so any chunk can be found without inflating
+   the ones before it */
+static I64 const chunk_bytes = I64(1) << 20;
+
+/* since version 10, each array in a compressed file starts with
+   its codec and the filters applied to each chunk before compression.
+   arrays that would not shrink are stored raw, like in an
+   uncompressed file */
+enum { RAW_CODEC = 0, ZLIB_CODEC = 1 };
+enum { DELTA_FILTER = 0x1, SHUFFLE_FILTER = 0x2 };
+
+/* integers such as connectivity and global numbers change slowly,
+   so their differences have mostly zero high bytes, and grouping
+   equal byte positions together helps all multi-byte values */
+template <typename T>
+static I8 get_filters() {
+  I8 filters = 0;
+  if (sizeof(T) > 1) filters |= SHUFFLE_FILTER;
+  if (sizeof(T) > 1 && std::is_integral<T>::value) filters |= DELTA_FILTER;
+  return filters;
+}
+
+template <typename T, bool is_integer = std::is_integral<T>::value>
+struct Delta {
+  static void encode(T*, LO) {}
+  static void decode(T*, LO) {}
+};
+
+template <typename T>
+struct Delta<T, true> {
+  typedef typename std::make_unsigned<T>::type U;
+  static void encode(T* p, LO n) {
+    for (LO i = n - 1; i > 0; --i) p[i] = T(U(p[i]) - U(p[i - 1]));
+  }
+  static void decode(T* p, LO n) {
+    for (LO i = 1; i < n; ++i) p[i] = T(U(p[i]) + U(p[i - 1]));
+  }
+};
+
+static void shuffle_bytes(
+    ::Bytef const* in, ::Bytef* out, LO n, std::size_t width) {
+  for (LO i = 0; i < n; ++i) {
+    for (std::size_t b = 0; b < width; ++b) {
+      out[b * std::size_t(n) + std::size_t(i)] = in[std::size_t(i) * width + b];
+    }
+  }
+}
+
+static void unshuffle_bytes(
+    ::Bytef const* in, ::Bytef* out, LO n, std::size_t width) {
+  for (LO i = 0; i < n; ++i) {
+    for (std::size_t b = 0; b < width; ++b) {
+      out[std::size_t(i) * width + b] = in[b * std::size_t(n) + std::size_t(i)];
+    }
+  }
+}
+
 template <typename T>
-void write_array(std::ostream& stream, Read<T> array) {
+static std::vector<std::vector< ::Bytef>> compress_chunks(
+    T const* data, LO size, I8 filters) {
+  auto chunk_size = LO(chunk_bytes / I64(sizeof(T)));
+  auto nchunks = (size + chunk_size - 1) / chunk_size;
+  auto chunks = std::vector<std::vector< ::Bytef>>(std::size_t(nchunks));
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (LO c = 0; c < nchunks; ++c) {
+    auto begin = c * chunk_size;
+    auto n = min2(chunk_size, size - begin);
+    std::vector<T> values(data + begin, data + begin + n);
+    if (filters & DELTA_FILTER) Delta<T>::encode(values.data(), n);
+    for (auto& value : values) swap_if_needed(value, true);
+    auto source_bytes = uLong(std::size_t(n) * sizeof(T));
+    auto source = reinterpret_cast< ::Bytef const*>(values.data());
+    std::vector< ::Bytef> shuffled;
+    if (filters & SHUFFLE_FILTER) {
+      shuffled.resize(source_bytes);
+      shuffle_bytes(source, shuffled.data(), n, sizeof(T));
+      source = shuffled.data();
+    }
+    auto dest_bytes = ::compressBound(source_bytes);
+    auto& chunk = chunks[std::size_t(c)];
+    chunk.resize(dest_bytes);
+    int ret = ::compress2(
+        chunk.data(), &dest_bytes, source, source_bytes, Z_BEST_SPEED);
+    OMEGA_H_CHECK(ret == Z_OK);
+    chunk.resize(dest_bytes);
+  }
+  return chunks;
+}
+
+static void write_chunks(
+    std::ostream& stream, std::vector<std::vector< ::Bytef>> const& chunks) {
+  write_value(stream, chunk_bytes);
+  for (auto& chunk : chunks) write_value(stream, I64(chunk.size()));
+  for (auto& chunk : chunks) {
+    stream.write(reinterpret_cast<char const*>(chunk.data()),
+        std::streamsize(chunk.size()));
+  }
+}
+
+template <typename T>
+static void read_chunks(std::istream& stream, T* data, LO size, I8 filters) {
+  I64 chunk_bytes_in;
+  read_value(stream, chunk_bytes_in);
+  OMEGA_H_CHECK(chunk_bytes_in > 0);
+  OMEGA_H_CHECK(chunk_bytes_in % I64(sizeof(T)) == 0);
+  auto chunk_size = LO(chunk_bytes_in / I64(sizeof(T)));
+  auto nchunks = (size + chunk_size - 1) / chunk_size;
+  OMEGA_H_CHECK(nchunks >= 0);
+  std::vector<I64> offsets(std::size_t(nchunks) + 1, 0);
+  I64 total_bytes = 0;
+  for (LO c = 0; c < nchunks; ++c) {
+    I64 compressed_bytes;
+    read_value(stream, compressed_bytes);
+    OMEGA_H_CHECK(compressed_bytes >= 0);
+    total_bytes += compressed_bytes;
+    offsets[std::size_t(c + 1)] = total_bytes;
+  }
+  auto compressed = std::vector< ::Bytef>(std::size_t(total_bytes));
+  stream.read(reinterpret_cast<char*>(compressed.data()),
+      std::streamsize(compressed.size()));
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (LO c = 0; c < nchunks; ++c) {
+    auto begin = c * chunk_size;
+    auto n = min2(chunk_size, size - begin);
+    auto values = data + begin;
+    auto expected_bytes = uLong(std::size_t(n) * sizeof(T));
+    auto dest = reinterpret_cast< ::Bytef*>(values);
+    std::vector< ::Bytef> shuffled;
+    if (filters & SHUFFLE_FILTER) {
+      shuffled.resize(expected_bytes);
+      dest = shuffled.data();
+    }
+    auto dest_bytes = expected_bytes;
+    auto source_begin = offsets[std::size_t(c)];
+    auto source_bytes = uLong(offsets[std::size_t(c + 1)] - source_begin);
+    int ret = ::uncompress(
+        dest, &dest_bytes, compressed.data() + source_begin, source_bytes);
+    OMEGA_H_CHECK(ret == Z_OK);
+    OMEGA_H_CHECK(dest_bytes == expected_bytes);
+    if (filters & SHUFFLE_FILTER) {
+      unshuffle_bytes(dest, reinterpret_cast< ::Bytef*>(values), n, sizeof(T));
+    }
+    for (LO i = 0; i < n; ++i) swap_if_needed(values[i], true);
+    if (filters & DELTA_FILTER) Delta<T>::decode(values, n);
+  }
+}
+#endif
+
+template <typename T>
+void write_array(std::ostream& stream, Read<T> array, bool compress) {
   LO size = array.size();
   write_value(stream, size);
-  Read<T> swapped = swap_if_needed(array, true);
-  HostRead<T> uncompressed(swapped);
   I64 uncompressed_bytes =
       static_cast<I64>(static_cast<std::size_t>(size) * sizeof(T));
 #ifdef OMEGA_H_USE_ZLIB
-  uLong source_bytes = static_cast<uLong>(uncompressed_bytes);
-  uLong dest_bytes = ::compressBound(source_bytes);
-  auto compressed = new ::Bytef[dest_bytes];
-  int ret = ::compress2(compressed, &dest_bytes,
-      reinterpret_cast<const ::Bytef*>(nonnull(uncompressed.data())),
-      source_bytes, Z_BEST_SPEED);
-  OMEGA_H_CHECK(ret == Z_OK);
-  I64 compressed_bytes = static_cast<I64>(dest_bytes);
-  write_value(stream, compressed_bytes);
-  stream.write(reinterpret_cast<const char*>(compressed), compressed_bytes);
-  delete[] compressed;
+  if (compress) {
+    HostRead<T> values(array);
+    auto filters = get_filters<T>();
+    auto chunks = compress_chunks(values.data(), size, filters);
+    I64 compressed_bytes = 0;
+    for (auto& chunk : chunks) compressed_bytes += I64(chunk.size());
+    if (compressed_bytes < uncompressed_bytes) {
+      write_value(stream, I8(ZLIB_CODEC));
+      write_value(stream, filters);
+      write_chunks(stream, chunks);
+      return;
+    }
+    write_value(stream, I8(RAW_CODEC));
+  }
 #else
+  (void)compress;
+#endif
+  Read<T> swapped = swap_if_needed(array, true);
+  HostRead<T> uncompressed(swapped);
+  auto padding = get_padding(stream.tellp(), sizeof(T));
+  for (std::streamoff i = 0; i < padding; ++i) stream.put('\0');
   stream.write(reinterpret_cast<const char*>(nonnull(uncompressed.data())),
       uncompressed_bytes);
-#endif
 }
 
 template <typename T>
-void read_array(std::istream& stream, Read<T>& array, bool is_compressed) {
+void read_array(
+    std::istream& stream, Read<T>& array, bool is_compressed, I32 version) {
   LO size;
   read_value(stream, size);
   OMEGA_H_CHECK(size >= 0);
   I64 uncompressed_bytes =
       static_cast<I64>(static_cast<std::size_t>(size) * sizeof(T));
-  HostWrite<T> uncompressed(size);
 #ifdef OMEGA_H_USE_ZLIB
-  if (is_compressed) {
+  I8 codec = is_compressed ? I8(ZLIB_CODEC) : I8(RAW_CODEC);
+  I8 filters = 0;
+  if (is_compressed && version >= 10) {
+    read_value(stream, codec);
+    OMEGA_H_CHECK(codec == RAW_CODEC || codec == ZLIB_CODEC);
+    if (codec == ZLIB_CODEC) read_value(stream, filters);
+  }
+  if (codec == ZLIB_CODEC && version >= 9) {
+    HostWrite<T> uncompressed(size);
+    read_chunks(stream, uncompressed.data(), size, filters);
+    array = Read<T>(uncompressed.write());
+    return;
+  }
+  if (codec == ZLIB_CODEC) {
+    HostWrite<T> uncompressed(size);
     I64 compressed_bytes;
     read_value(stream, compressed_bytes);
     OMEGA_H_CHECK(compressed_bytes >= 0);
@@ -213,14 +588,25 @@ void read_array(std::istream& stream, Read<T>& array, bool is_compressed) {
     OMEGA_H_CHECK(ret == Z_OK);
     OMEGA_H_CHECK(dest_bytes == static_cast<uLong>(uncompressed_bytes));
     delete[] compressed;
-  } else
+    array = swap_if_needed(Read<T>(uncompressed.write()), true);
+    return;
+  }
 #else
   OMEGA_H_CHECK(is_compressed == false);
 #endif
-  {
-    stream.read(reinterpret_cast<char*>(nonnull(uncompressed.data())),
-        uncompressed_bytes);
+  if (version >= 8) {
+    stream.ignore(get_padding(stream.tellg(), sizeof(T)));
+  }
+#ifndef OMEGA_H_USE_KOKKOSCORE
+  auto mapped = dynamic_cast<MappedBuffer*>(stream.rdbuf());
+  if (mapped && is_little_endian_cpu() && mapped->can_take<T>(size)) {
+    array = mapped->take<T>(size);
+    return;
   }
+#endif
+  HostWrite<T> uncompressed(size);
+  stream.read(reinterpret_cast<char*>(nonnull(uncompressed.data())),
+      uncompressed_bytes);
   array = swap_if_needed(Read<T>(uncompressed.write()), true);
 }
 
@@ -238,15 +624,14 @@ void read(std::istream& stream, std::string& val) {
   stream.read(&val[0], len);
 }
 
-static void write_meta(std::ostream& stream, Mesh const* mesh) {
+static void write_meta(
+    std::ostream& stream, Mesh const* mesh, I32 nparts, I32 part) {
   auto family = I8(mesh->family());
   write_value(stream, family);
   auto dim = I8(mesh->dim());
   write_value(stream, dim);
-  I32 comm_size = mesh->comm()->size();
-  write_value(stream, comm_size);
-  I32 comm_rank = mesh->comm()->rank();
-  write_value(stream, comm_rank);
+  write_value(stream, nparts);
+  write_value(stream, part);
   I8 parting = mesh->parting();
   write_value(stream, parting);
   I32 nghost_layers = mesh->nghost_layers();
@@ -263,7 +648,8 @@ static void write_meta(std::ostream& stream, Mesh const* mesh) {
   }
 }
 
-static void read_meta(std::istream& stream, Mesh* mesh, Int version) {
+static void read_meta(std::istream& stream, Mesh* mesh, Int version,
+    I32 nparts, I32 part) {
   if (version >= 7) {
     I8 family;
     read_value(stream, family);
@@ -274,10 +660,10 @@ static void read_meta(std::istream& stream, Mesh* mesh, Int version) {
   mesh->set_dim(Int(dim));
   I32 comm_size;
   read_value(stream, comm_size);
-  OMEGA_H_CHECK(mesh->comm()->size() == comm_size);
+  OMEGA_H_CHECK(nparts == comm_size);
   I32 comm_rank;
   read_value(stream, comm_rank);
-  OMEGA_H_CHECK(mesh->comm()->rank() == comm_rank);
+  OMEGA_H_CHECK(part == comm_rank);
   I8 parting_i8;
   read_value(stream, parting_i8);
   OMEGA_H_CHECK(parting_i8 == I8(OMEGA_H_ELEM_BASED) ||
@@ -309,7 +695,8 @@ static void read_meta(std::istream& stream, Mesh* mesh, Int version) {
   }
 }
 
-static void write_tag(std::ostream& stream, TagBase const* tag) {
+static void write_tag(
+    std::ostream& stream, TagBase const* tag, bool compress) {
   std::string name = tag->name();
   write(stream, name);
   auto ncomps = I8(tag->ncomps());
@@ -317,20 +704,60 @@ static void write_tag(std::ostream& stream, TagBase const* tag) {
   I8 type = tag->type();
   write_value(stream, type);
   if (is<I8>(tag)) {
-    write_array(stream, as<I8>(tag)->array());
+    write_array(stream, as<I8>(tag)->array(), compress);
   } else if (is<I32>(tag)) {
-    write_array(stream, as<I32>(tag)->array());
+    write_array(stream, as<I32>(tag)->array(), compress);
   } else if (is<I64>(tag)) {
-    write_array(stream, as<I64>(tag)->array());
+    write_array(stream, as<I64>(tag)->array(), compress);
   } else if (is<Real>(tag)) {
-    write_array(stream, as<Real>(tag)->array());
+    write_array(stream, as<Real>(tag)->array(), compress);
   } else {
     Omega_h_fail("unexpected tag type in binary write\n");
   }
 }
 
-static void read_tag(
-    std::istream& stream, Mesh* mesh, Int d, bool is_compressed, I32 version) {
+/* since version 11, the tags of each dimension are preceded by
+   the size of each one, and each starts at a multiple of this
+   from the start of the stream, so readers can skip tags */
+constexpr std::size_t tag_alignment = 8;
+
+/* how read() treats tags: only those in (tags) are read if it is
+   given, and the arrays of indexed tags are read from (lazy_path)
+   when first asked for if it is not empty */
+struct TagReadOptions {
+  TagSet const* tags = nullptr;
+  std::string lazy_path;
+};
+
+template <typename T>
+static void read_tag_array(std::istream& stream, Mesh* mesh, Int d,
+    std::string const& name, Int ncomps, bool is_compressed, I32 version,
+    std::string const& lazy_path) {
+  if (!lazy_path.empty() && version >= 11) {
+    auto pos = stream.tellg();
+    auto size = mesh->nents(d) * ncomps;
+    std::function<Read<T>()> loader = [=]() {
+      std::ifstream file(lazy_path.c_str(), std::ios::binary);
+      OMEGA_H_CHECK(file.is_open());
+      file.seekg(pos);
+      Read<T> array;
+      read_array(file, array, is_compressed, version);
+      OMEGA_H_CHECK(array.size() == size);
+      return array;
+    };
+    mesh->add_lazy_tag(d, name, ncomps, loader);
+    return;
+  }
+  Read<T> array;
+  read_array(stream, array, is_compressed, version);
+  /* without an index, unwanted tags still have to be read past */
+  if (mesh) mesh->add_tag(d, name, ncomps, array, true);
+}
+
+/* with an index (since version 11) the caller skips unwanted tags,
+   so they are left unread here */
+static void read_tag(std::istream& stream, Mesh* mesh, Int d,
+    bool is_compressed, I32 version, TagReadOptions const& options) {
   std::string name;
   read(stream, name);
   I8 ncomps;
@@ -345,63 +772,127 @@ static void read_tag(
       read_value(stream, outflags_i8);
     }
   }
+  if (options.tags && !(*options.tags)[std::size_t(d)].count(name)) {
+    if (version >= 11) return;
+    mesh = nullptr;
+  }
+  auto const& lazy_path = options.lazy_path;
   if (type == OMEGA_H_I8) {
-    Read<I8> array;
-    read_array(stream, array, is_compressed);
-    mesh->add_tag(d, name, ncomps, array, true);
+    read_tag_array<I8>(
+        stream, mesh, d, name, ncomps, is_compressed, version, lazy_path);
   } else if (type == OMEGA_H_I32) {
-    Read<I32> array;
-    read_array(stream, array, is_compressed);
-    mesh->add_tag(d, name, ncomps, array, true);
+    read_tag_array<I32>(
+        stream, mesh, d, name, ncomps, is_compressed, version, lazy_path);
   } else if (type == OMEGA_H_I64) {
-    Read<I64> array;
-    read_array(stream, array, is_compressed);
-    mesh->add_tag(d, name, ncomps, array, true);
+    read_tag_array<I64>(
+        stream, mesh, d, name, ncomps, is_compressed, version, lazy_path);
   } else if (type == OMEGA_H_F64) {
-    Read<Real> array;
-    read_array(stream, array, is_compressed);
-    mesh->add_tag(d, name, ncomps, array, true);
+    read_tag_array<Real>(
+        stream, mesh, d, name, ncomps, is_compressed, version, lazy_path);
   } else {
     Omega_h_fail("unexpected tag type in binary read\n");
   }
 }
 
-void write(std::ostream& stream, Mesh* mesh) {
-  begin_code("binary::write(stream,Mesh)");
+/* writes the tags of dimension (d) after the table of their sizes.
+   on a stream that can seek, each tag is written as it is and the
+   table is filled in afterwards. otherwise the tags are first
+   written to memory to find their sizes */
+static void write_tags(std::ostream& stream, Mesh* mesh, Int d,
+    bool is_compressed, bool can_seek) {
+  auto ntags = mesh->ntags(d);
+  write_value(stream, ntags);
+  if (!can_seek) {
+    std::vector<std::string> records;
+    for (Int i = 0; i < ntags; ++i) {
+      std::ostringstream record;
+      write_tag(record, mesh->get_tag(d, i), is_compressed);
+      records.push_back(record.str());
+    }
+    for (auto& record : records) write_value(stream, I64(record.size()));
+    for (auto& record : records) {
+      auto padding = get_padding(stream.tellp(), tag_alignment);
+      for (std::streamoff i = 0; i < padding; ++i) stream.put('\0');
+      stream.write(record.data(), std::streamsize(record.size()));
+    }
+    return;
+  }
+  auto table = stream.tellp();
+  for (Int i = 0; i < ntags; ++i) write_value(stream, I64(0));
+  auto sizes = std::vector<I64>(std::size_t(ntags));
+  for (Int i = 0; i < ntags; ++i) {
+    auto padding = get_padding(stream.tellp(), tag_alignment);
+    for (std::streamoff j = 0; j < padding; ++j) stream.put('\0');
+    auto begin = stream.tellp();
+    write_tag(stream, mesh->get_tag(d, i), is_compressed);
+    sizes[std::size_t(i)] = I64(stream.tellp() - begin);
+  }
+  auto end = stream.tellp();
+  stream.seekp(table);
+  for (auto size : sizes) write_value(stream, size);
+  stream.seekp(end);
+  OMEGA_H_CHECK(stream.good());
+}
+
+/* writes (mesh) as part (part) of (nparts) without calling its
+   communicator or the profiler, so it can run on another thread.
+   (can_seek) is false for streams that only count their position */
+static void write_part(std::ostream& stream, Mesh* mesh, bool compress,
+    I32 nparts, I32 part, bool can_seek = true) {
+  if (stream.tellp() == std::ostream::pos_type(-1)) {
+    CountingBuffer counter(stream.rdbuf());
+    std::ostream counted(&counter);
+    write_part(counted, mesh, compress, nparts, part, false);
+    if (!counted) stream.setstate(std::ios_base::badbit);
+    return;
+  }
   stream.write(reinterpret_cast<const char*>(magic), sizeof(magic));
 // write_value(stream, latest_version); moved to /version at version 4
 #ifdef OMEGA_H_USE_ZLIB
-  I8 is_compressed = true;
+  I8 is_compressed = compress;
 #else
   I8 is_compressed = false;
 #endif
   write_value(stream, is_compressed);
-  write_meta(stream, mesh);
+  write_meta(stream, mesh, nparts, part);
   LO nverts = mesh->nverts();
   write_value(stream, nverts);
   for (Int d = 1; d <= mesh->dim(); ++d) {
     auto down = mesh->ask_down(d, d - 1);
-    write_array(stream, down.ab2b);
+    write_array(stream, down.ab2b, is_compressed);
     if (d > 1) {
-      write_array(stream, down.codes);
+      write_array(stream, down.codes, is_compressed);
     }
   }
   for (Int d = 0; d <= mesh->dim(); ++d) {
-    auto nsaved_tags = mesh->ntags(d);
-    write_value(stream, nsaved_tags);
-    for (Int i = 0; i < mesh->ntags(d); ++i) {
-      write_tag(stream, mesh->get_tag(d, i));
-    }
-    if (mesh->comm()->size() > 1) {
+    write_tags(stream, mesh, d, is_compressed, can_seek);
+    if (nparts > 1) {
       auto owners = mesh->ask_owners(d);
-      write_array(stream, owners.ranks);
-      write_array(stream, owners.idxs);
+      write_array(stream, owners.ranks, is_compressed);
+      write_array(stream, owners.idxs, is_compressed);
     }
   }
+}
+
+void write(std::ostream& stream, Mesh* mesh, bool compress) {
+  begin_code("binary::write(stream,Mesh)");
+  auto comm = mesh->comm();
+  write_part(stream, mesh, compress, comm->size(), comm->rank());
   end_code();
 }
 
-void read(std::istream& stream, Mesh* mesh, I32 version) {
+/* reads part (part) of a mesh that was written by (nparts) ranks.
+   the communicator of (mesh) is usually the one of that size,
+   but a smaller one may read parts to merge them */
+static void read_part(std::istream& stream, Mesh* mesh, I32 version,
+    I32 nparts, I32 part, TagReadOptions const& options = TagReadOptions()) {
+  if (stream.tellg() == std::istream::pos_type(-1)) {
+    CountingBuffer counter(stream.rdbuf());
+    std::istream counted(&counter);
+    read_part(counted, mesh, version, nparts, part, options);
+    if (!counted) stream.setstate(std::ios_base::failbit);
+    return;
+  }
   unsigned char magic_in[2];
   stream.read(reinterpret_cast<char*>(magic_in), sizeof(magic));
   OMEGA_H_CHECK(magic_in[0] == magic[0]);
@@ -414,33 +905,49 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
 #ifndef OMEGA_H_USE_ZLIB
   OMEGA_H_CHECK(!is_compressed);
 #endif
-  read_meta(stream, mesh, version);
+  read_meta(stream, mesh, version, nparts, part);
   LO nverts;
   read_value(stream, nverts);
   mesh->set_verts(nverts);
   for (Int d = 1; d <= mesh->dim(); ++d) {
     Adj down;
-    read_array(stream, down.ab2b, is_compressed);
+    read_array(stream, down.ab2b, is_compressed, version);
     if (d > 1) {
-      read_array(stream, down.codes, is_compressed);
+      read_array(stream, down.codes, is_compressed, version);
     }
     mesh->set_ents(d, down);
   }
   for (Int d = 0; d <= mesh->dim(); ++d) {
     Int ntags;
     read_value(stream, ntags);
-    for (Int i = 0; i < ntags; ++i) {
-      read_tag(stream, mesh, d, is_compressed, version);
+    if (version >= 11) {
+      auto sizes = std::vector<I64>(std::size_t(ntags));
+      for (auto& size : sizes) read_value(stream, size);
+      for (auto size : sizes) {
+        stream.ignore(get_padding(stream.tellg(), tag_alignment));
+        auto begin = stream.tellg();
+        read_tag(stream, mesh, d, is_compressed, version, options);
+        stream.seekg(begin + std::streamoff(size));
+      }
+    } else {
+      for (Int i = 0; i < ntags; ++i) {
+        read_tag(stream, mesh, d, is_compressed, version, options);
+      }
     }
-    if (mesh->comm()->size() > 1) {
+    if (nparts > 1) {
       Remotes owners;
-      read_array(stream, owners.ranks, is_compressed);
-      read_array(stream, owners.idxs, is_compressed);
+      read_array(stream, owners.ranks, is_compressed, version);
+      read_array(stream, owners.idxs, is_compressed, version);
       mesh->set_owners(d, owners);
     }
   }
 }
 
+void read(std::istream& stream, Mesh* mesh, I32 version) {
+  auto comm = mesh->comm();
+  read_part(stream, mesh, version, comm->size(), comm->rank());
+}
+
 static void write_int_file(std::string const& filepath, Mesh* mesh, I32 value) {
   if (mesh->comm()->rank() == 0) {
     std::ofstream file(filepath.c_str());
@@ -492,8 +999,8 @@ I32 read_version(std::string const& path, CommPtr comm) {
   return version;
 }
 
-void write(std::string const& path, Mesh* mesh) {
-  begin_code("binary::write(path,Mesh)");
+/* creates the directory and returns the path of this rank's file */
+static std::string start_write(std::string const& path, Mesh* mesh) {
   if (!ends_with(path, ".osh") && can_print(mesh)) {
     std::cout
         << "it is strongly recommended to end Omega_h paths in \".osh\",\n";
@@ -501,37 +1008,149 @@ void write(std::string const& path, Mesh* mesh) {
   }
   safe_mkdir(path.c_str());
   mesh->comm()->barrier();
-  auto filepath = path + "/" + to_string(mesh->comm()->rank()) + ".osh";
+  return path + "/" + to_string(mesh->comm()->rank()) + ".osh";
+}
+
+static void write_part(std::string const& filepath, Mesh* mesh, bool compress,
+    I32 nparts, I32 part) {
   std::ofstream file(filepath.c_str());
   OMEGA_H_CHECK(file.is_open());
-  write(file, mesh);
+  write_part(file, mesh, compress, nparts, part);
+}
+
+void write(std::string const& path, Mesh* mesh, bool compress) {
+  begin_code("binary::write(path,Mesh)");
+  auto filepath = start_write(path, mesh);
+  auto comm = mesh->comm();
+  write_part(filepath, mesh, compress, comm->size(), comm->rank());
   write_nparts(path, mesh);
   write_version(path, mesh);
   mesh->comm()->barrier();
   end_code();
 }
 
-void read_in_comm(
-    std::string const& path, CommPtr comm, Mesh* mesh, I32 version) {
+template <typename T>
+static void add_same_tag(Mesh* mesh, Int d, TagBase const* tag) {
+  mesh->add_tag(d, tag->name(), tag->ncomps(), as<T>(tag)->array(), true);
+}
+
+/* a mesh with the same arrays, but its own tags and adjacencies,
+   so later changes to (mesh) can not reach it */
+static Mesh snapshot_mesh(Mesh* mesh) {
+  auto snapshot = mesh->copy_meta();
+  snapshot.set_verts(mesh->nverts());
+  for (Int d = 1; d <= mesh->dim(); ++d) {
+    snapshot.set_ents(d, mesh->ask_down(d, d - 1));
+  }
+  for (Int d = 0; d <= mesh->dim(); ++d) {
+    if (mesh->comm()->size() > 1) snapshot.set_owners(d, mesh->ask_owners(d));
+    for (Int i = 0; i < mesh->ntags(d); ++i) {
+      auto tag = mesh->get_tag(d, i);
+      switch (tag->type()) {
+        case OMEGA_H_I8:
+          add_same_tag<I8>(&snapshot, d, tag);
+          break;
+        case OMEGA_H_I32:
+          add_same_tag<I32>(&snapshot, d, tag);
+          break;
+        case OMEGA_H_I64:
+          add_same_tag<I64>(&snapshot, d, tag);
+          break;
+        case OMEGA_H_F64:
+          add_same_tag<Real>(&snapshot, d, tag);
+          break;
+      }
+    }
+  }
+  return snapshot;
+}
+
+/* the communicator is only used on the calling thread, its size
+   and rank are taken here for the background thread */
+struct WriteRequest::State {
+  Mesh snapshot;
+  CommPtr comm;
+  I32 comm_size;
+  I32 comm_rank;
+  std::thread thread;
+  bool waited;
+  State(Mesh* mesh)
+      : snapshot(snapshot_mesh(mesh)),
+        comm(mesh->comm()),
+        comm_size(mesh->comm()->size()),
+        comm_rank(mesh->comm()->rank()),
+        waited(false) {}
+  ~State() {
+    if (thread.joinable()) thread.join();
+  }
+};
+
+WriteRequest::WriteRequest() {}
+
+void WriteRequest::wait() {
+  if (!state_ || state_->waited) return;
+  begin_code("binary::WriteRequest::wait");
+  if (state_->thread.joinable()) state_->thread.join();
+  state_->comm->barrier();
+  state_->waited = true;
+  end_code();
+}
+
+WriteRequest write_async(std::string const& path, Mesh* mesh, bool compress) {
+  begin_code("binary::write_async");
+  auto filepath = start_write(path, mesh);
+  write_nparts(path, mesh);
+  write_version(path, mesh);
+  WriteRequest request;
+  request.state_ = std::make_shared<WriteRequest::State>(mesh);
+  auto nparts = request.state_->comm_size;
+  auto part = request.state_->comm_rank;
+#ifdef OMEGA_H_USE_KOKKOSCORE
+  write_part(filepath, mesh, compress, nparts, part);
+#else
+  auto snapshot = &request.state_->snapshot;
+  request.state_->thread = std::thread(
+      [=]() { write_part(filepath, snapshot, compress, nparts, part); });
+#endif
+  end_code();
+  return request;
+}
+
+static void read_in_comm(std::string const& path, CommPtr comm, Mesh* mesh,
+    I32 version, TagSet const* tags, bool lazy) {
   mesh->set_comm(comm);
   auto filepath = path + "/" + to_string(mesh->comm()->rank());
   if (version != -1) filepath += ".osh";
   std::ifstream file(filepath.c_str());
   OMEGA_H_CHECK(file.is_open());
-  read(file, mesh, version);
+  TagReadOptions options;
+  options.tags = tags;
+  if (lazy) options.lazy_path = filepath;
+  read_part(file, mesh, version, comm->size(), comm->rank(), options);
 }
 
-I32 read(std::string const& path, CommPtr comm, Mesh* mesh, bool strict) {
+void read_in_comm(
+    std::string const& path, CommPtr comm, Mesh* mesh, I32 version) {
+  read_in_comm(path, comm, mesh, version, nullptr, false);
+}
+
+static void check_strict_nparts(
+    std::string const& path, CommPtr comm, I32 nparts) {
+  if (nparts != comm->size()) {
+    Omega_h_fail("Mesh \"%s\" is being read in strict mode"
+                 " (no repartitioning) and its number of parts %d"
+                 " doesn't match the number of MPI ranks %d\n",
+        path.c_str(), nparts, comm->size());
+  }
+}
+
+static I32 read(std::string const& path, CommPtr comm, Mesh* mesh,
+    bool strict, TagSet const* tags, bool lazy) {
   auto nparts = read_nparts(path, comm);
   auto version = read_version(path, comm);
   if (strict) {
-    if (nparts != comm->size()) {
-      Omega_h_fail("Mesh \"%s\" is being read in strict mode"
-                   " (no repartitioning) and its number of parts %d"
-                   " doesn't match the number of MPI ranks %d\n",
-                   path.c_str(), nparts, comm->size());
-    }
-    read_in_comm(path, comm, mesh, version);
+    check_strict_nparts(path, comm, nparts);
+    read_in_comm(path, comm, mesh, version, tags, lazy);
   } else {
     if (nparts > comm->size()) {
       Omega_h_fail(
@@ -541,13 +1160,17 @@ I32 read(std::string const& path, CommPtr comm, Mesh* mesh, bool strict) {
     auto in_subcomm = (comm->rank() < nparts);
     auto subcomm = comm->split(I32(!in_subcomm), 0);
     if (in_subcomm) {
-      read_in_comm(path, subcomm, mesh, version);
+      read_in_comm(path, subcomm, mesh, version, tags, lazy);
     }
     mesh->set_comm(comm);
   }
   return nparts;
 }
 
+I32 read(std::string const& path, CommPtr comm, Mesh* mesh, bool strict) {
+  return binary::read(path, comm, mesh, strict, nullptr, false);
+}
+
 Mesh read(std::string const& path, Library* lib, bool strict) {
   return binary::read(path, lib->world(), strict);
 }
@@ -558,14 +1181,335 @@ Mesh read(std::string const& path, CommPtr comm, bool strict) {
   return mesh;
 }
 
+Mesh read(
+    std::string const& path, CommPtr comm, TagSet const& tags, bool strict) {
+  begin_code("binary::read(path,TagSet)");
+  auto mesh = Mesh(comm->library());
+  binary::read(path, comm, &mesh, strict, &tags, false);
+  end_code();
+  return mesh;
+}
+
+Mesh read_lazy(std::string const& path, CommPtr comm, bool strict) {
+  begin_code("binary::read_lazy");
+  auto mesh = Mesh(comm->library());
+  binary::read(path, comm, &mesh, strict, nullptr, true);
+  end_code();
+  return mesh;
+}
+
+Mesh read_mapped(std::string const& path, CommPtr comm) {
+  begin_code("binary::read_mapped");
+  auto nparts = read_nparts(path, comm);
+  auto version = read_version(path, comm);
+  check_strict_nparts(path, comm, nparts);
+  auto mesh = Mesh(comm->library());
+  mesh.set_comm(comm);
+  auto filepath = path + "/" + to_string(comm->rank());
+  if (version != -1) filepath += ".osh";
+  MappedBuffer buffer(std::make_shared<FileMapping>(filepath));
+  std::istream stream(&buffer);
+  read(stream, &mesh, version);
+  end_code();
+  return mesh;
+}
+
+/* a shared file starts with the magic bytes, the version,
+   the number of parts and the (nparts + 1) offsets of the parts
+   in the file, and each part is what write(stream, Mesh) writes */
+static I64 get_shared_header_size(I32 nparts) {
+  return I64(sizeof(magic)) + 2 * I64(sizeof(I32)) +
+         I64(nparts + 1) * I64(sizeof(I64));
+}
+
+/* all ranks write their (data) at their (offset) at the same time */
+static void write_shared_data(CommPtr comm, std::string const& path,
+    I64 offset, std::string const& data) {
+#ifdef OMEGA_H_USE_MPI
+  MPI_File file;
+  OMEGA_H_CHECK(MPI_SUCCESS == MPI_File_open(comm->get_impl(), path.c_str(),
+                                   MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                   MPI_INFO_NULL, &file));
+  OMEGA_H_CHECK(MPI_SUCCESS == MPI_File_set_size(file, 0));
+  /* MPI counts are int, so large parts take several collective calls */
+  constexpr I64 max_count = I64(1) << 30;
+  auto size = I64(data.size());
+  auto ncalls =
+      comm->allreduce((size + max_count - 1) / max_count, OMEGA_H_MAX);
+  for (I64 i = 0; i < ncalls; ++i) {
+    auto begin = std::min(i * max_count, size);
+    auto count = int(std::min(max_count, size - begin));
+    OMEGA_H_CHECK(MPI_SUCCESS ==
+                  MPI_File_write_at_all(file, MPI_Offset(offset + begin),
+                      data.data() + begin, count, MPI_BYTE, MPI_STATUS_IGNORE));
+  }
+  OMEGA_H_CHECK(MPI_SUCCESS == MPI_File_close(&file));
+#else
+  if (comm->rank() == 0) {
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    OMEGA_H_CHECK(file.is_open());
+  }
+  comm->barrier();
+  std::fstream file(
+      path.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+  OMEGA_H_CHECK(file.is_open());
+  file.seekp(std::streamoff(offset));
+  file.write(data.data(), std::streamsize(data.size()));
+  OMEGA_H_CHECK(file.good());
+#endif
+}
+
+void write_shared(std::string const& path, Mesh* mesh, bool compress) {
+  begin_code("binary::write_shared");
+  auto comm = mesh->comm();
+  auto nparts = comm->size();
+  auto header_size = get_shared_header_size(nparts);
+  /* rank 0 writes the header in front of its part, so it is kept
+     in the same buffer, which is the only copy of the part */
+  std::string data;
+  if (comm->rank() == 0) data.resize(std::size_t(header_size));
+  {
+    StringBuffer buffer(data);
+    std::ostream part_stream(&buffer);
+    write(part_stream, mesh, compress);
+    OMEGA_H_CHECK(part_stream.good());
+  }
+  auto size = I64(data.size());
+  if (comm->rank() == 0) size -= header_size;
+  auto offset = header_size + comm->exscan(size, OMEGA_H_SUM);
+  HostWrite<I64> posted(nparts + 1);
+  for (I32 i = 0; i <= nparts; ++i) posted[i] = 0;
+  posted[comm->rank()] = offset;
+  if (comm->rank() == nparts - 1) posted[nparts] = offset + size;
+  auto offsets = HostRead<I64>(
+      comm->allreduce(Read<I64>(posted.write()), OMEGA_H_SUM));
+  if (comm->rank() == 0) {
+    std::ostringstream header;
+    header.write(reinterpret_cast<const char*>(magic), sizeof(magic));
+    write_value(header, latest_version);
+    write_value(header, nparts);
+    for (I32 i = 0; i <= nparts; ++i) write_value(header, offsets[i]);
+    auto header_data = header.str();
+    OMEGA_H_CHECK(I64(header_data.size()) == header_size);
+    data.replace(0, header_data.size(), header_data);
+    offset = 0;
+  }
+  write_shared_data(comm, path, offset, data);
+  comm->barrier();
+  end_code();
+}
+
+struct SharedHeader {
+  I32 version;
+  I32 nparts;
+  std::vector<I64> offsets;
+};
+
+static SharedHeader read_shared_header(std::string const& path) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file.is_open()) {
+    Omega_h_fail("could not open file \"%s\"\n", path.c_str());
+  }
+  unsigned char magic_in[2];
+  file.read(reinterpret_cast<char*>(magic_in), sizeof(magic));
+  OMEGA_H_CHECK(magic_in[0] == magic[0]);
+  OMEGA_H_CHECK(magic_in[1] == magic[1]);
+  SharedHeader header;
+  read_value(file, header.version);
+  OMEGA_H_CHECK(header.version >= 8);
+  OMEGA_H_CHECK(header.version <= latest_version);
+  read_value(file, header.nparts);
+  OMEGA_H_CHECK(header.nparts >= 1);
+  header.offsets.resize(std::size_t(header.nparts + 1));
+  for (auto& offset : header.offsets) read_value(file, offset);
+  OMEGA_H_CHECK(file.good());
+  return header;
+}
+
+static void read_shared_part(std::string const& path,
+    SharedHeader const& header, I32 part, Mesh* mesh) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  OMEGA_H_CHECK(file.is_open());
+  auto begin = header.offsets[std::size_t(part)];
+  file.seekg(std::streamoff(begin));
+  /* positions inside a part count from its start */
+  CountingBuffer counter(file.rdbuf());
+  std::istream stream(&counter);
+  read_part(stream, mesh, header.version, header.nparts, part);
+  OMEGA_H_CHECK(stream.good());
+}
+
+template <typename T>
+static Read<T> concat_arrays(std::vector<Read<T>> const& arrays) {
+  LO size = 0;
+  for (auto& a : arrays) size += a.size();
+  Write<T> out(size);
+  LO begin = 0;
+  for (auto& a : arrays) {
+    map_into(a, LOs(a.size(), begin, 1), out, 1);
+    begin += a.size();
+  }
+  return out;
+}
+
+/* the vertex global numbers of each entity of dimension (d) of each part */
+static Read<GO> concat_ent_vert_globals(std::vector<Mesh>& parts, Int d) {
+  std::vector<Read<GO>> arrays;
+  for (auto& part : parts) {
+    auto vert_globals = part.get_array<GO>(VERT, "global");
+    if (d == VERT) {
+      arrays.push_back(vert_globals);
+    } else {
+      arrays.push_back(unmap(part.ask_verts_of(d), vert_globals, 1));
+    }
+  }
+  return concat_arrays(arrays);
+}
+
+template <typename T>
+static void add_merged_tag(Mesh* mesh, std::vector<Mesh>& parts, Int d,
+    TagBase const* tag, LOs ents2part_ents) {
+  std::vector<Read<T>> arrays;
+  for (auto& part : parts) arrays.push_back(part.get_array<T>(d, tag->name()));
+  auto data = unmap(ents2part_ents, concat_arrays(arrays), tag->ncomps());
+  mesh->add_tag(d, tag->name(), tag->ncomps(), data, true);
+}
+
+/* builds the local mesh of this rank from the elements that the parts
+   (first_part, ...) owned, matching their vertices across the parts
+   (and across ranks) by global number. the other tags are then taken
+   from any copy of each entity, found by its vertex global numbers */
+static void merge_shared_parts(
+    Mesh* mesh, CommPtr comm, std::vector<Mesh>& parts, I32 first_part) {
+  auto& first = parts.front();
+  auto dim = first.dim();
+  auto family = first.family();
+  auto deg = element_degree(family, dim, VERT);
+  std::vector<Read<GO>> ev2g_arrays;
+  std::vector<Read<GO>> elem_global_arrays;
+  std::vector<Read<LO>> elem_arrays;
+  LO elem_begin = 0;
+  for (std::size_t i = 0; i < parts.size(); ++i) {
+    auto& part = parts[i];
+    OMEGA_H_CHECK(part.has_tag(VERT, "global"));
+    auto owned = collect_marked(
+        each_eq_to(part.ask_owners(dim).ranks, first_part + I32(i)));
+    auto vert_globals = part.get_array<GO>(VERT, "global");
+    auto ev2g = unmap(part.ask_elem_verts(), vert_globals, 1);
+    ev2g_arrays.push_back(unmap(owned, ev2g, deg));
+    auto elem_globals = part.get_array<GO>(dim, "global");
+    elem_global_arrays.push_back(unmap(owned, elem_globals, 1));
+    elem_arrays.push_back(add_to_each(owned, elem_begin));
+    elem_begin += part.nelems();
+  }
+  auto ev2g = HostRead<GO>(concat_arrays(ev2g_arrays));
+  std::vector<GO> globals(ev2g.data(), ev2g.data() + ev2g.size());
+  std::sort(globals.begin(), globals.end());
+  globals.erase(std::unique(globals.begin(), globals.end()), globals.end());
+  auto find_vert = [&](GO global) {
+    return LO(std::lower_bound(globals.begin(), globals.end(), global) -
+              globals.begin());
+  };
+  HostWrite<LO> ev2v(ev2g.size());
+  for (LO i = 0; i < ev2g.size(); ++i) ev2v[i] = find_vert(ev2g[i]);
+  auto nverts = LO(globals.size());
+  HostWrite<GO> vert_globals(nverts);
+  for (LO i = 0; i < nverts; ++i) vert_globals[i] = globals[std::size_t(i)];
+  auto part_vert_globals = HostRead<GO>(concat_ent_vert_globals(parts, VERT));
+  HostWrite<LO> verts2part_verts(nverts);
+  for (LO i = 0; i < nverts; ++i) verts2part_verts[i] = -1;
+  for (LO i = 0; i < part_vert_globals.size(); ++i) {
+    auto global = part_vert_globals[i];
+    auto vert = find_vert(global);
+    if (vert < nverts && globals[std::size_t(vert)] == global &&
+        verts2part_verts[vert] == -1) {
+      verts2part_verts[vert] = i;
+    }
+  }
+  mesh->set_comm(comm);
+  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  mesh->set_family(family);
+  mesh->set_dim(dim);
+  build_verts_from_globals(mesh, vert_globals.write());
+  build_ents_from_elems2verts(mesh, ev2v.write(), vert_globals.write(),
+      concat_arrays(elem_global_arrays));
+  for (Int d = 0; d <= dim; ++d) {
+    LOs ents2part_ents;
+    if (d == VERT) {
+      ents2part_ents = verts2part_verts.write();
+    } else if (d == dim) {
+      ents2part_ents = concat_arrays(elem_arrays);
+    } else {
+      auto ent_deg = element_degree(family, d, VERT);
+      auto ent_vert_globals = unmap(
+          mesh->ask_verts_of(d), mesh->get_array<GO>(VERT, "global"), 1);
+      Read<I8> codes;
+      find_matches_by_hashing_ex(ent_deg, ent_vert_globals,
+          concat_ent_vert_globals(parts, d), &ents2part_ents, &codes, true);
+    }
+    for (Int i = 0; i < first.ntags(d); ++i) {
+      auto tag = first.get_tag(d, i);
+      if (mesh->has_tag(d, tag->name())) continue;
+      switch (tag->type()) {
+        case OMEGA_H_I8:
+          add_merged_tag<I8>(mesh, parts, d, tag, ents2part_ents);
+          break;
+        case OMEGA_H_I32:
+          add_merged_tag<I32>(mesh, parts, d, tag, ents2part_ents);
+          break;
+        case OMEGA_H_I64:
+          add_merged_tag<I64>(mesh, parts, d, tag, ents2part_ents);
+          break;
+        case OMEGA_H_F64:
+          add_merged_tag<Real>(mesh, parts, d, tag, ents2part_ents);
+          break;
+      }
+    }
+  }
+  if (first.parting() != OMEGA_H_ELEM_BASED) {
+    mesh->set_parting(first.parting(), first.nghost_layers(), false);
+  }
+}
+
+Mesh read_shared(std::string const& path, CommPtr comm) {
+  begin_code("binary::read_shared");
+  auto header = read_shared_header(path);
+  auto nparts = header.nparts;
+  auto mesh = Mesh(comm->library());
+  if (nparts <= comm->size()) {
+    auto in_subcomm = (comm->rank() < nparts);
+    auto subcomm = comm->split(I32(!in_subcomm), 0);
+    if (in_subcomm) {
+      mesh.set_comm(subcomm);
+      read_shared_part(path, header, subcomm->rank(), &mesh);
+    }
+    mesh.set_comm(comm);
+  } else {
+    /* each rank merges a contiguous range of parts, since parts
+       with nearby numbers tend to be nearby in space */
+    auto first_part = I32(I64(nparts) * comm->rank() / comm->size());
+    auto end_part = I32(I64(nparts) * (comm->rank() + 1) / comm->size());
+    std::vector<Mesh> parts;
+    for (auto part = first_part; part < end_part; ++part) {
+      parts.push_back(Mesh(comm->library()));
+      parts.back().set_comm(comm->library()->self());
+      read_shared_part(path, header, part, &parts.back());
+    }
+    merge_shared_parts(&mesh, comm, parts, first_part);
+  }
+  end_code();
+  return mesh;
+}
+
 #define OMEGA_H_INST(T)                                                        \
   template void swap_if_needed(T& val, bool is_little_endian);                 \
   template Read<T> swap_if_needed(Read<T> array, bool is_little_endian);       \
   template void write_value(std::ostream& stream, T val);                      \
   template void read_value(std::istream& stream, T& val);                      \
-  template void write_array(std::ostream& stream, Read<T> array);              \
-  template void read_array(                                                    \
-      std::istream& stream, Read<T>& array, bool is_compressed);
+  template void write_array(                                                   \
+      std::ostream& stream, Read<T> array, bool compress);                     \
+  template void read_array(std::istream& stream, Read<T>& array,               \
+      bool is_compressed, I32 version);
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
@@ -99,16 +99,66 @@ class FullWriter {
 
 namespace binary {
 
-void write(std::string const& path, Mesh* mesh);
+/* (compress) only has an effect when zlib is available */
+void write(std::string const& path, Mesh* mesh, bool compress = true);
 Mesh read(std::string const& path, Library* lib, bool strict = false);
 Mesh read(std::string const& path, CommPtr comm, bool strict = false);
+/* reads only the tags named in (tags). since version 11 the size
+   of each tag is stored ahead of the tags, so the others are
+   skipped without being read or decompressed */
+Mesh read(std::string const& path, CommPtr comm, TagSet const& tags,
+    bool strict = false);
+/* reads the mesh, but each tag array (of files since version 11)
+   is only read from its file when first asked for,
+   so the files must not change until then */
+Mesh read_lazy(std::string const& path, CommPtr comm, bool strict = false);
+/* reads in strict mode by mapping each part file into memory.
+   arrays written uncompressed are used in place rather than copied
+   (except with Kokkos), and keep their file mapped, so the files
+   must not change while the mesh or arrays taken from it exist */
+Mesh read_mapped(std::string const& path, CommPtr comm);
+
+/* a write started by write_async(). wait() blocks until this rank's
+   part file is complete and then waits for the other ranks,
+   so like write() it must be called on all ranks.
+   copies share the same write, and waiting again does nothing */
+class WriteRequest {
+ public:
+  WriteRequest();
+  void wait();
+
+ private:
+  struct State;
+  std::shared_ptr<State> state_;
+  friend WriteRequest write_async(
+      std::string const& path, Mesh* mesh, bool compress);
+};
+
+/* writes the same files as write(), but returns once the
+   directory and the small shared files are written. each part
+   file is written by a background thread from a snapshot of
+   the mesh, which shares its arrays instead of copying them,
+   so the mesh may be modified or adapted in the meantime.
+   with Kokkos, the part file is written before returning */
+WriteRequest write_async(
+    std::string const& path, Mesh* mesh, bool compress = true);
+/* writes all parts into the single file (path) instead of one file
+   per rank. the ranks find where their part goes with an exscan,
+   and then write at the same time (collectively with MPI-IO) */
+void write_shared(std::string const& path, Mesh* mesh, bool compress = true);
+/* reads a file from write_shared() onto any number of ranks.
+   with fewer parts than ranks, the first ranks read one part each
+   and the others are left empty, like non-strict read().
+   with more parts than ranks, each rank reads a range of parts
+   and merges their owned elements by vertex global numbers */
+Mesh read_shared(std::string const& path, CommPtr comm);
 I32 read(std::string const& path, CommPtr comm, Mesh* mesh, bool strict = false);
 I32 read_nparts(std::string const& path, CommPtr comm);
 I32 read_version(std::string const& path, CommPtr comm);
 void read_in_comm(
     std::string const& path, CommPtr comm, Mesh* mesh, I32 version);
 
-constexpr I32 latest_version = 7;
+constexpr I32 latest_version = 11;
 
 template <typename T>
 void swap_if_needed(T& val, bool is_little_endian = true);
@@ -120,14 +170,15 @@ void write_value(std::ostream& stream, T val);
 template <typename T>
 void read_value(std::istream& stream, T& val);
 template <typename T>
-void write_array(std::ostream& stream, Read<T> array);
+void write_array(std::ostream& stream, Read<T> array, bool compress = true);
 template <typename T>
-void read_array(std::istream& stream, Read<T>& array, bool is_compressed);
+void read_array(std::istream& stream, Read<T>& array, bool is_compressed,
+    I32 version = latest_version);
 
 void write(std::ostream& stream, std::string const& val);
 void read(std::istream& stream, std::string& val);
 
-void write(std::ostream& stream, Mesh* mesh);
+void write(std::ostream& stream, Mesh* mesh, bool compress = true);
 void read(std::istream& stream, Mesh* mesh, I32 version);
 
 #define INST_DECL(T)                                                           \
@@ -136,9 +187,10 @@ void read(std::istream& stream, Mesh* mesh, I32 version);
       Read<T> array, bool is_little_endian);                                   \
   extern template void write_value(std::ostream& stream, T val);               \
   extern template void read_value(std::istream& stream, T& val);               \
-  extern template void write_array(std::ostream& stream, Read<T> array);       \
-  extern template void read_array(                                             \
-      std::istream& stream, Read<T>& array, bool is_compressed);
+  extern template void write_array(                                            \
+      std::ostream& stream, Read<T> array, bool compress);                     \
+  extern template void read_array(std::istream& stream, Read<T>& array,        \
+      bool is_compressed, I32 version);
 INST_DECL(I8)
 INST_DECL(I32)
 INST_DECL(I64)
@@ -1,7 +1,10 @@
 #include "Omega_h_ghost.hpp"
 
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_element.hpp"
 #include "Omega_h_loop.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_migrate.hpp"
 
@@ -130,7 +133,117 @@ void partition_by_verts(Mesh* mesh, bool verbose) {
   migrate_mesh(mesh, elems2owners, OMEGA_H_VERT_BASED, verbose);
 }
 
+template <typename T>
+static std::shared_ptr<TagBase> keep_tag(TagBase const* tag, LOs new2old) {
+  auto kept = std::make_shared<Tag<T>>(tag->name(), tag->ncomps());
+  kept->set_array(unmap(new2old, as<T>(tag)->array(), tag->ncomps()));
+  return kept;
+}
+
+static std::shared_ptr<TagBase> keep_tag(TagBase const* tag, LOs new2old) {
+  switch (tag->type()) {
+    case OMEGA_H_I8:
+      return keep_tag<I8>(tag, new2old);
+    case OMEGA_H_I32:
+      return keep_tag<I32>(tag, new2old);
+    case OMEGA_H_I64:
+      return keep_tag<I64>(tag, new2old);
+    case OMEGA_H_F64:
+      return keep_tag<Real>(tag, new2old);
+  }
+  return std::shared_ptr<TagBase>();
+}
+
+template <typename T>
+static void add_kept_tag(Mesh* mesh, Int ent_dim, TagBase const* tag) {
+  mesh->add_tag<T>(
+      ent_dim, tag->name(), tag->ncomps(), as<T>(tag)->array(), true);
+}
+
+static void add_kept_tag(Mesh* mesh, Int ent_dim, TagBase const* tag) {
+  switch (tag->type()) {
+    case OMEGA_H_I8:
+      add_kept_tag<I8>(mesh, ent_dim, tag);
+      break;
+    case OMEGA_H_I32:
+      add_kept_tag<I32>(mesh, ent_dim, tag);
+      break;
+    case OMEGA_H_I64:
+      add_kept_tag<I64>(mesh, ent_dim, tag);
+      break;
+    case OMEGA_H_F64:
+      add_kept_tag<Real>(mesh, ent_dim, tag);
+      break;
+  }
+}
+
+/* ghosting keeps every entity owned by the rank that owned it in the
+   element-based partitioning, so each rank already has the closure
+   of the elements it owns, and the owners of all of it.
+   this drops the ghost layers without migrating anything: each rank
+   keeps that closure in its current order, which like the order
+   migrate_mesh() produces follows the global numbers.
+   only the owners' new local numbers and the shared tag values
+   are exchanged.
+   returns false if some owner does not keep its entity, which means
+   the mesh was not ghosted from an element-based partitioning */
+static bool drop_ghost_layers(Mesh* mesh) {
+  begin_code("drop_ghost_layers");
+  auto comm = mesh->comm();
+  auto dim = mesh->dim();
+  LOs new2old[DIMS];
+  LOs old2new[DIMS];
+  Remotes owners[DIMS];
+  auto elems_kept = mesh->owned(dim);
+  for (Int d = 0; d <= dim; ++d) {
+    auto kept = mark_local_closure(mesh, d, elems_kept);
+    new2old[d] = collect_marked(kept);
+    old2new[d] = invert_injective_map(new2old[d], mesh->nents(d));
+    auto nnew = new2old[d].size();
+    if (d == dim) {
+      owners[d] = Remotes(Read<I32>(nnew, comm->rank()), LOs(nnew, 0, 1));
+      continue;
+    }
+    auto copies2own_idxs = mesh->sync_array(d, old2new[d], 1);
+    owners[d].ranks = unmap(new2old[d], mesh->ask_owners(d).ranks, 1);
+    owners[d].idxs = unmap(new2old[d], copies2own_idxs, 1);
+    if (get_min(comm, owners[d].idxs) < 0) {
+      end_code();
+      return false;
+    }
+  }
+  auto new_mesh = mesh->copy_meta();
+  new_mesh.set_verts(new2old[VERT].size());
+  for (Int d = 1; d <= dim; ++d) {
+    auto deg = element_degree(mesh->family(), d, d - 1);
+    auto old_down = mesh->ask_down(d, d - 1);
+    Adj new_down;
+    auto new2old_lows = unmap(new2old[d], old_down.ab2b, deg);
+    new_down.ab2b = unmap(new2old_lows, old2new[d - 1], 1);
+    if (old_down.codes.exists()) {
+      new_down.codes = unmap(new2old[d], old_down.codes, deg);
+    }
+    new_mesh.set_ents(d, new_down);
+  }
+  for (Int d = 0; d <= dim; ++d) {
+    new_mesh.set_owners(d, owners[d]);
+    std::vector<std::shared_ptr<TagBase>> kept;
+    std::vector<TagBase const*> kept_ptrs;
+    for (Int i = 0; i < mesh->ntags(d); ++i) {
+      kept.push_back(keep_tag(mesh->get_tag(d, i), new2old[d]));
+      kept_ptrs.push_back(kept.back().get());
+    }
+    /* copies take their owners' values, as a migration would give them */
+    if (d < dim) kept = exch_tags(new_mesh.ask_inverse_dist(d), kept_ptrs);
+    for (auto& tag : kept) add_kept_tag(&new_mesh, d, tag.get());
+  }
+  *mesh = new_mesh;
+  end_code();
+  return true;
+}
+
 void partition_by_elems(Mesh* mesh, bool verbose) {
+  if (mesh->parting() == OMEGA_H_GHOSTED && drop_ghost_layers(mesh)) return;
   auto dim = mesh->dim();
   auto all2owners = mesh->ask_owners(dim);
   auto marked_owned = mesh->owned(dim);
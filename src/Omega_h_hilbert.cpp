@@ -1,7 +1,12 @@
 #include "Omega_h_hilbert.hpp"
 
+#include <algorithm>
+#include <vector>
+
+#include "Omega_h_array_ops.hpp"
 #include "Omega_h_bbox.hpp"
 #include "Omega_h_loop.hpp"
+#include "Omega_h_map.hpp"
 #include "Omega_h_sort.hpp"
 
 namespace Omega_h {
@@ -21,8 +26,7 @@ namespace hilbert {
    bits, and the last integer getting the least significant bits. */
 
 template <Int dim>
-static Read<I64> dists_from_coords_dim(Reals coords) {
-  auto bbox = find_bounding_box<dim>(coords);
+static Read<I64> dists_from_coords_dim(Reals coords, BBox<dim> bbox) {
   bbox = make_equilateral(bbox);
   auto unit_affine = get_affine_from_bbox_into_unit(bbox);
   auto npts = divide_no_remainder(coords.size(), dim);
@@ -42,6 +46,11 @@ static Read<I64> dists_from_coords_dim(Reals coords) {
   return out;
 }
 
+template <Int dim>
+static Read<I64> dists_from_coords_dim(Reals coords) {
+  return dists_from_coords_dim<dim>(coords, find_bounding_box<dim>(coords));
+}
+
 static Read<I64> dists_from_coords(Reals coords, Int dim) {
   if (dim == 3) return dists_from_coords_dim<3>(coords);
   if (dim == 2) return dists_from_coords_dim<2>(coords);
@@ -49,11 +58,113 @@ static Read<I64> dists_from_coords(Reals coords, Int dim) {
   OMEGA_H_NORETURN(Read<I64>());
 }
 
+/* the most significant word of the Hilbert distances,
+   over the bounding box of the coordinates on all ranks */
+template <Int dim>
+static Read<I64> global_leading_dists_dim(CommPtr comm, Reals coords) {
+  auto bbox = find_bounding_box<dim>(coords);
+  for (Int i = 0; i < dim; ++i) {
+    bbox.min[i] = comm->allreduce(bbox.min[i], OMEGA_H_MIN);
+    bbox.max[i] = comm->allreduce(bbox.max[i], OMEGA_H_MAX);
+  }
+  return get_component(dists_from_coords_dim<dim>(coords, bbox), dim, 0);
+}
+
+static Read<I64> global_leading_dists(CommPtr comm, Reals coords, Int dim) {
+  if (dim == 3) return global_leading_dists_dim<3>(comm, coords);
+  if (dim == 2) return global_leading_dists_dim<2>(comm, coords);
+  if (dim == 1) return global_leading_dists_dim<1>(comm, coords);
+  OMEGA_H_NORETURN(Read<I64>());
+}
+
 LOs sort_coords(Reals coords, Int dim) {
   auto keys = hilbert::dists_from_coords(coords, dim);
   return sort_by_keys(keys, dim);
 }
 
+/* the parts are separated by (nparts - 1) splitting distances,
+   each found by bisecting the range of distances until the
+   global mass before it is as close to its share as the points
+   allow. all splitters are bisected together, so each round
+   costs one reduction of (nparts - 1) values, and a splitter
+   stops once no point lies in its remaining range. */
+Read<I32> partition_coords(
+    CommPtr comm, Reals coords, Int dim, Reals masses) {
+  auto nparts = comm->size();
+  auto npts = masses.size();
+  auto dists = global_leading_dists(comm, coords, dim);
+  auto sorted2pts = sort_by_keys(dists);
+  auto sorted_dists = HostRead<I64>(unmap(sorted2pts, dists, 1));
+  auto sorted_masses = HostRead<Real>(unmap(sorted2pts, masses, 1));
+  std::vector<Real> mass_before(std::size_t(npts + 1), 0.0);
+  for (LO i = 0; i < npts; ++i) {
+    mass_before[std::size_t(i + 1)] = mass_before[std::size_t(i)] +
+                                      sorted_masses[i];
+  }
+  auto total_mass = comm->allreduce(mass_before.back(), OMEGA_H_SUM);
+  auto nsplits = nparts - 1;
+  std::vector<I64> lo(std::size_t(nsplits), 0);
+  std::vector<I64> hi(std::size_t(nsplits), I64(1) << MANTISSA_BITS);
+  std::vector<Real> lo_mass(std::size_t(nsplits), 0.0);
+  std::vector<Real> hi_mass(std::size_t(nsplits), total_mass);
+  auto is_open = [&](std::size_t i) {
+    return hi[i] - lo[i] > 1 && hi_mass[i] > lo_mass[i];
+  };
+  while (true) {
+    bool any_open = false;
+    HostWrite<I64> mids(nsplits);
+    HostWrite<Real> local_mass(nsplits);
+    for (std::size_t i = 0; i < std::size_t(nsplits); ++i) {
+      any_open = any_open || is_open(i);
+      auto mid = lo[i] + (hi[i] - lo[i]) / 2;
+      auto first = sorted_dists.data();
+      auto nbefore = std::lower_bound(first, first + npts, mid) - first;
+      mids[LO(i)] = mid;
+      local_mass[LO(i)] = mass_before[std::size_t(nbefore)];
+    }
+    if (!any_open) break;
+    auto global_mass = HostRead<Real>(
+        comm->allreduce(Read<Real>(local_mass.write()), OMEGA_H_SUM));
+    for (std::size_t i = 0; i < std::size_t(nsplits); ++i) {
+      if (!is_open(i)) continue;
+      auto target = total_mass * Real(i + 1) / Real(nparts);
+      if (global_mass[LO(i)] < target) {
+        lo[i] = mids[LO(i)];
+        lo_mass[i] = global_mass[LO(i)];
+      } else {
+        hi[i] = mids[LO(i)];
+        hi_mass[i] = global_mass[LO(i)];
+      }
+    }
+  }
+  HostWrite<I64> h_splitters(nsplits);
+  for (std::size_t i = 0; i < std::size_t(nsplits); ++i) {
+    auto target = total_mass * Real(i + 1) / Real(nparts);
+    auto closer_to_lo = (target - lo_mass[i]) <= (hi_mass[i] - target);
+    h_splitters[LO(i)] = closer_to_lo ? lo[i] : hi[i];
+  }
+  auto splitters = Read<I64>(h_splitters.write());
+  Write<I32> parts(npts);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto dist = dists[i];
+    /* the number of splitters at or before this distance */
+    LO first = 0;
+    LO count = nsplits;
+    while (count > 0) {
+      auto step = count / 2;
+      if (splitters[first + step] <= dist) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    parts[i] = first;
+  };
+  parallel_for(npts, f, "hilbert::partition_coords");
+  return parts;
+}
+
 }  // end namespace hilbert
 
 }  // end namespace Omega_h
@@ -5,6 +5,7 @@
 
 #include <Omega_h_affine.hpp>
 #include <Omega_h_array.hpp>
+#include <Omega_h_comm.hpp>
 #include <Omega_h_kokkos.hpp>
 #include <Omega_h_vector.hpp>
 
@@ -157,6 +158,13 @@ OMEGA_H_INLINE Few<hilbert::coord_t, dim> from_spatial(
    the bounding box of the points */
 LOs sort_coords(Reals coords, Int dim);
 
+/* cuts a Hilbert curve through the bounding box of the points
+   on all ranks into (comm->size()) stretches of nearly equal
+   total mass, and returns the stretch of each local point.
+   points that move a little stay in the same stretch, so
+   repeating this on a slowly changing mesh moves few points */
+Read<I32> partition_coords(CommPtr comm, Reals coords, Int dim, Reals masses);
+
 }  // end namespace hilbert
 
 }  // end namespace Omega_h
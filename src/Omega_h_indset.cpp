@@ -117,7 +117,7 @@ GOs find_indset(Graph graph, Int distance, Bytes candidates, Reals qualities,
 Read<I8> find_indset(
     Mesh* mesh, Int ent_dim, Graph graph, Reals qualities, Bytes candidates) {
   auto globals = mesh->globals(ent_dim);
-  auto owners2copies = mesh->ask_dist(ent_dim).invert();
+  auto owners2copies = mesh->ask_inverse_dist(ent_dim);
   auto distance = 1;
   auto indset_globals = find_indset(
       graph, distance, candidates, qualities, globals, owners2copies);
@@ -1,12 +1,17 @@
 #include "Omega_h_laplace.hpp"
 
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_indset.hpp"
+#include "Omega_h_loop.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_sort.hpp"
 
 namespace Omega_h {
 
@@ -41,4 +46,355 @@ Reals solve_laplacian(
   return state;
 }
 
+namespace laplace {
+
+enum {
+  NSMOOTH_SWEEPS = 1,
+  NCOARSEST_SWEEPS = 16,
+  MIN_COARSE_ROWS = 32,
+  MAX_LEVELS = 24,
+};
+
+constexpr Real jacobi_damping = 2.0 / 3.0;
+
+/* a symmetric matrix stored as its diagonal plus one off-diagonal
+   value per arc of a graph.
+   the finest level is the vertex star of the mesh and its rows
+   are only valid for owned vertices until synchronized.
+   coarser levels are local to each MPI rank. */
+struct Level {
+  Graph graph;
+  Reals diag;
+  Reals offdiag;
+  /* maps rows of the next finer level to rows of this level,
+     or to -1 for rows which were not aggregated */
+  LOs fine2coarse;
+  /* the inverse of fine2coarse, for restriction */
+  Graph coarse2fine;
+};
+
+}  // namespace laplace
+
+/* the Dirichlet problem for the correction: interior rows are
+   the graph Laplacian without the boundary columns, and boundary
+   rows are decoupled identity rows, which keeps it symmetric */
+static laplace::Level build_fine_level(Mesh* mesh, Read<I8> interior) {
+  auto star = mesh->ask_star(VERT);
+  auto nverts = mesh->nverts();
+  Write<Real> diag(nverts);
+  Write<Real> offdiag(star.nedges());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto b = star.a2ab[v];
+    auto e = star.a2ab[v + 1];
+    diag[v] = interior[v] ? Real(e - b) : 1.0;
+    for (auto vw = b; vw < e; ++vw) {
+      auto w = star.ab2b[vw];
+      offdiag[vw] = (interior[v] && interior[w]) ? -1.0 : 0.0;
+    }
+  };
+  parallel_for(nverts, f, "build_fine_level");
+  laplace::Level level;
+  level.graph = star;
+  level.diag = diag;
+  level.offdiag = offdiag;
+  return level;
+}
+
+/* the product of one level's matrix with x, not yet synchronized */
+static Reals multiply_level(laplace::Level const& level, Reals x) {
+  auto a2ab = level.graph.a2ab;
+  auto ab2b = level.graph.ab2b;
+  auto diag = level.diag;
+  auto offdiag = level.offdiag;
+  auto n = level.diag.size();
+  Write<Real> y(n);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto sum = diag[i] * x[i];
+    for (auto ij = a2ab[i]; ij < a2ab[i + 1]; ++ij) {
+      sum += offdiag[ij] * x[ab2b[ij]];
+    }
+    y[i] = sum;
+  };
+  parallel_for(n, f, "multiply_level");
+  return y;
+}
+
+static Reals apply_level(Mesh* mesh, laplace::Level const& level, Reals x) {
+  auto y = multiply_level(level, x);
+  if (mesh) return mesh->sync_array(VERT, y, 1);
+  return y;
+}
+
+/* damped Jacobi sweeps on A x = b.
+   mesh is non-null only for the finest level */
+static Reals smooth_level(
+    Mesh* mesh, laplace::Level const& level, Reals b, Reals x, Int nsweeps) {
+  auto diag = level.diag;
+  for (Int sweep = 0; sweep < nsweeps; ++sweep) {
+    auto ax = apply_level(mesh, level, x);
+    Write<Real> new_x(x.size());
+    auto f = OMEGA_H_LAMBDA(LO i) {
+      new_x[i] = x[i] + laplace::jacobi_damping * (b[i] - ax[i]) / diag[i];
+    };
+    parallel_for(x.size(), f, "laplace_jacobi_sweep");
+    x = new_x;
+  }
+  return x;
+}
+
+/* aggregates rows around the roots of a distance-2 independent set,
+   as in the find_indset() reference by Bell, Dalton, and Olson.
+   the set is computed locally, so aggregates never span MPI ranks */
+static LOs aggregate_rows(
+    CommPtr self, Graph graph, Read<I8> candidates, LO* p_ncoarse) {
+  auto n = graph.nnodes();
+  Write<Real> qualities(n);
+  auto hash = OMEGA_H_LAMBDA(LO i) {
+    auto h = std::uint32_t(i) * std::uint32_t(2654435761u);
+    h ^= h >> 16;
+    qualities[i] = Real(h) / 4294967296.0;
+  };
+  parallel_for(n, hash, "aggregate_rows(hash)");
+  auto globals = GOs(n, 0, 1);
+  Dist local_dist;
+  local_dist.set_parent_comm(self);
+  auto roots =
+      find_indset(graph, 2, candidates, qualities, globals, local_dist);
+  auto coarse2root = collect_marked(each_eq(roots, globals));
+  auto root2coarse = invert_injective_map(coarse2root, n);
+  *p_ncoarse = coarse2root.size();
+  Write<LO> fine2coarse(n);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto root = roots[i];
+    fine2coarse[i] = (root == -1) ? -1 : root2coarse[LO(root)];
+  };
+  parallel_for(n, f, "aggregate_rows");
+  return fine2coarse;
+}
+
+/* the Galerkin product P^T A P for piecewise-constant P.
+   couplings to rows outside any aggregate (boundary rows and
+   vertices owned by other ranks) are dropped, which keeps the
+   coarse matrix symmetric and diagonally dominant */
+static laplace::Level coarsen_level(
+    laplace::Level const& fine, LOs fine2coarse, LO nc) {
+  auto a2ab = fine.graph.a2ab;
+  auto ab2b = fine.graph.ab2b;
+  auto fine_diag = fine.diag;
+  auto fine_offdiag = fine.offdiag;
+  auto n = fine.diag.size();
+  auto is_aggregated = each_geq_to(fine2coarse, LO(0));
+  auto aggregated2fine = collect_marked(is_aggregated);
+  auto aggregated2coarse = unmap(aggregated2fine, fine2coarse, 1);
+  Write<Real> fine_contribs(n);
+  Write<I8> arcs_are_coarse(fine.graph.nedges());
+  auto contribute = OMEGA_H_LAMBDA(LO i) {
+    auto c = fine2coarse[i];
+    auto sum = 0.0;
+    if (c != -1) sum = fine_diag[i];
+    for (auto ij = a2ab[i]; ij < a2ab[i + 1]; ++ij) {
+      auto d = fine2coarse[ab2b[ij]];
+      if (c != -1 && d == c) sum += fine_offdiag[ij];
+      arcs_are_coarse[ij] = (c != -1 && d != -1 && d != c);
+    }
+    fine_contribs[i] = sum;
+  };
+  parallel_for(n, contribute, "coarsen_level(contribute)");
+  auto c2agg = invert_map_by_sorting(aggregated2coarse, nc);
+  auto agg_contribs = unmap(aggregated2fine, Reals(fine_contribs), 1);
+  auto coarse_diag = fan_reduce(
+      c2agg.a2ab, unmap(c2agg.ab2b, agg_contribs, 1), 1, OMEGA_H_SUM);
+  auto kept2arc = collect_marked(Read<I8>(arcs_are_coarse));
+  auto arc2row = invert_fan(a2ab);
+  auto nkept = kept2arc.size();
+  Write<LO> keys(nkept * 2);
+  auto make_keys = OMEGA_H_LAMBDA(LO k) {
+    auto ij = kept2arc[k];
+    keys[k * 2 + 0] = fine2coarse[arc2row[ij]];
+    keys[k * 2 + 1] = fine2coarse[ab2b[ij]];
+  };
+  parallel_for(nkept, make_keys, "coarsen_level(keys)");
+  auto perm = sort_by_keys(LOs(keys), 2);
+  auto sorted_keys = unmap(perm, LOs(keys), 2);
+  auto sorted_vals = unmap(compound_maps(perm, kept2arc), fine_offdiag, 1);
+  Write<I8> starts_arc(nkept);
+  auto mark_starts = OMEGA_H_LAMBDA(LO k) {
+    starts_arc[k] =
+        (k == 0 || sorted_keys[k * 2 + 0] != sorted_keys[(k - 1) * 2 + 0] ||
+            sorted_keys[k * 2 + 1] != sorted_keys[(k - 1) * 2 + 1]);
+  };
+  parallel_for(nkept, mark_starts, "coarsen_level(starts)");
+  auto arcs2sorted = collect_marked(Read<I8>(starts_arc));
+  auto ncarcs = arcs2sorted.size();
+  Write<LO> arcs2sorted_fan(ncarcs + 1);
+  Write<LO> carc2crow(ncarcs);
+  Write<LO> carc2ccol(ncarcs);
+  auto fill_arcs = OMEGA_H_LAMBDA(LO a) {
+    auto k = arcs2sorted[a];
+    arcs2sorted_fan[a] = k;
+    carc2crow[a] = sorted_keys[k * 2 + 0];
+    carc2ccol[a] = sorted_keys[k * 2 + 1];
+  };
+  parallel_for(ncarcs, fill_arcs, "coarsen_level(arcs)");
+  arcs2sorted_fan.set(ncarcs, nkept);
+  laplace::Level coarse;
+  coarse.graph = Graph(invert_funnel(carc2crow, nc), carc2ccol);
+  coarse.diag = coarse_diag;
+  coarse.offdiag =
+      fan_reduce(LOs(arcs2sorted_fan), sorted_vals, 1, OMEGA_H_SUM);
+  coarse.fine2coarse = fine2coarse;
+  coarse.coarse2fine =
+      Graph(c2agg.a2ab, unmap(c2agg.ab2b, aggregated2fine, 1));
+  return coarse;
+}
+
+static std::vector<laplace::Level> build_levels(
+    Mesh* mesh, Read<I8> interior, bool use_multigrid) {
+  std::vector<laplace::Level> levels;
+  levels.push_back(build_fine_level(mesh, interior));
+  if (!use_multigrid) return levels;
+  auto self = mesh->library()->self();
+  /* the finest level always gets a coarse level, even an empty one,
+     so every rank performs the same number of fine-level syncs */
+  auto candidates = land_each(mesh->owned(VERT), interior);
+  while (int(levels.size()) < laplace::MAX_LEVELS) {
+    auto fine = levels.back();
+    LO ncoarse;
+    auto fine2coarse = aggregate_rows(self, fine.graph, candidates, &ncoarse);
+    levels.push_back(coarsen_level(fine, fine2coarse, ncoarse));
+    auto nfine = fine.diag.size();
+    if (ncoarse <= laplace::MIN_COARSE_ROWS) break;
+    if (ncoarse * 2 > nfine) break;
+    candidates = Read<I8>(ncoarse, I8(1));
+  }
+  return levels;
+}
+
+static Reals prolong_from_coarse(LOs fine2coarse, Reals xc, Reals x) {
+  Write<Real> new_x(x.size());
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto c = fine2coarse[i];
+    new_x[i] = x[i] + ((c == -1) ? 0.0 : xc[c]);
+  };
+  parallel_for(x.size(), f, "prolong_from_coarse");
+  return new_x;
+}
+
+/* a symmetric V-cycle, usable as a CG preconditioner */
+static Reals apply_vcycle(Mesh* mesh,
+    std::vector<laplace::Level> const& levels, std::size_t l, Reals b) {
+  auto level_mesh = (l == 0) ? mesh : nullptr;
+  auto const& level = levels[l];
+  auto x = Reals(b.size(), 0.0);
+  if (l + 1 == levels.size()) {
+    return smooth_level(level_mesh, level, b, x, laplace::NCOARSEST_SWEEPS);
+  }
+  x = smooth_level(level_mesh, level, b, x, laplace::NSMOOTH_SWEEPS);
+  auto r = subtract_each(b, apply_level(level_mesh, level, x));
+  auto const& coarse = levels[l + 1];
+  auto rc = graph_reduce(coarse.coarse2fine, r, 1, OMEGA_H_SUM);
+  auto xc = apply_vcycle(mesh, levels, l + 1, rc);
+  x = prolong_from_coarse(coarse.fine2coarse, xc, x);
+  if (level_mesh) x = mesh->sync_array(VERT, x, 1);
+  return smooth_level(level_mesh, level, b, x, laplace::NSMOOTH_SWEEPS);
+}
+
+static Reals apply_preconditioner(
+    Mesh* mesh, std::vector<laplace::Level> const& levels, Reals r) {
+  if (levels.size() > 1) return apply_vcycle(mesh, levels, 0, r);
+  return divide_each(r, levels[0].diag);
+}
+
+/* residual of the unmodified Laplacian for the current state,
+   zero on boundary vertices */
+static Reals laplacian_residual(
+    Mesh* mesh, Graph star, Read<I8> interior, Reals x) {
+  auto nverts = mesh->nverts();
+  Write<Real> r(nverts);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto sum = 0.0;
+    if (interior[v]) {
+      auto b = star.a2ab[v];
+      auto e = star.a2ab[v + 1];
+      for (auto vw = b; vw < e; ++vw) sum += x[star.ab2b[vw]];
+      sum -= Real(e - b) * x[v];
+    }
+    r[v] = sum;
+  };
+  parallel_for(nverts, f, "laplacian_residual");
+  return mesh->sync_array(VERT, Reals(r), 1);
+}
+
+static Reals axpy(Real a, Reals x, Reals y) {
+  Write<Real> out(x.size());
+  auto f = OMEGA_H_LAMBDA(LO i) { out[i] = a * x[i] + y[i]; };
+  parallel_for(x.size(), f, "axpy");
+  return out;
+}
+
+/* repro_sum() works in units of the largest magnitude or one,
+   which is too coarse for residuals near convergence */
+static Real dot_owned(Mesh* mesh, Reals a, Reals b) {
+  auto owned_products = mesh->owned_array(VERT, multiply_each(a, b), 1);
+  return get_sum(mesh->comm(), owned_products);
+}
+
+Reals solve_laplacian_cg(Mesh* mesh, Reals initial, Int width, Real tol,
+    bool use_multigrid, Int max_iters) {
+  OMEGA_H_CHECK(mesh->owners_have_all_upward(VERT));
+  OMEGA_H_CHECK(initial.size() == mesh->nverts() * width);
+  auto comm = mesh->comm();
+  auto star = mesh->ask_star(VERT);
+  auto interior = mark_by_class_dim(mesh, VERT, mesh->dim());
+  auto levels = build_levels(mesh, interior, use_multigrid);
+  auto fine = levels[0];
+  auto state_w = deep_copy(initial);
+  Int niters = 0;
+  bool converged = true;
+  for (Int comp = 0; comp < width; ++comp) {
+    auto x = get_component(initial, width, comp);
+    auto r = laplacian_residual(mesh, star, interior, x);
+    auto z = apply_preconditioner(mesh, levels, r);
+    auto p = z;
+    auto rz = dot_owned(mesh, r, z);
+    auto r0_norm = std::sqrt(dot_owned(mesh, r, r));
+    auto r_norm = r0_norm;
+    Int comp_iters = 0;
+    while (r_norm > tol * r0_norm) {
+      if (comp_iters == max_iters) {
+        converged = false;
+        break;
+      }
+      /* the dot product only reads owned values, which are final
+         before the ghost values of A p arrive */
+      auto local_ap = multiply_level(fine, p);
+      auto ap_request = mesh->sync_array_begin(VERT, local_ap, 1);
+      auto alpha = rz / dot_owned(mesh, p, local_ap);
+      auto ap = ap_request.wait();
+      x = axpy(alpha, p, x);
+      r = axpy(-alpha, ap, r);
+      r_norm = std::sqrt(dot_owned(mesh, r, r));
+      z = apply_preconditioner(mesh, levels, r);
+      auto new_rz = dot_owned(mesh, r, z);
+      p = axpy(new_rz / rz, p, z);
+      rz = new_rz;
+      ++comp_iters;
+    }
+    niters += comp_iters;
+    set_component(state_w, x, width, comp);
+  }
+  if (comm->rank() == 0) {
+    std::cout << "conjugate gradient laplacian solve took " << niters
+              << " iterations";
+    if (use_multigrid) std::cout << " with " << levels.size() << " levels";
+    std::cout << '\n';
+    if (!converged) {
+      std::cout << "warning: conjugate gradient laplacian solve stopped"
+                << " after " << max_iters << " iterations without"
+                << " reducing the residual by " << tol << '\n';
+    }
+  }
+  return state_w;
+}
+
 }  // end namespace Omega_h
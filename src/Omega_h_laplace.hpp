@@ -10,6 +10,14 @@ class Mesh;
 Reals solve_laplacian(
     Mesh* mesh, Reals initial, Int width, Real tol, Real floor = EPSILON);
 
+/* solves the same problem with preconditioned conjugate gradients,
+   stopping once the residual norm drops by a factor of tol,
+   or after max_iters iterations per component (with a warning).
+   the preconditioner is either the diagonal or an aggregation
+   multigrid V-cycle built from the vertex star graph */
+Reals solve_laplacian_cg(Mesh* mesh, Reals initial, Int width, Real tol,
+    bool use_multigrid = true, Int max_iters = 1000);
+
 }  // end namespace Omega_h
 
 #endif
@@ -4,6 +4,12 @@
 #include <Omega_h_defines.hpp>
 #include <Omega_h_kokkos.hpp>
 
+#if defined(OMEGA_H_USE_OPENMP) && !defined(OMEGA_H_USE_KOKKOSCORE)
+#include <omp.h>
+#include <atomic>
+#include <vector>
+#endif
+
 namespace Omega_h {
 
 #ifdef OMEGA_H_USE_KOKKOSCORE
@@ -12,12 +18,56 @@ using StaticSched = Kokkos::Schedule<Kokkos::Static>;
 using Policy = Kokkos::RangePolicy<ExecSpace, StaticSched>;
 
 inline Policy policy(LO n) { return Policy(0, static_cast<std::size_t>(n)); }
+
+using DynamicSched = Kokkos::Schedule<Kokkos::Dynamic>;
+using DynamicPolicy = Kokkos::RangePolicy<ExecSpace, DynamicSched>;
+
+inline DynamicPolicy dynamic_policy(LO n, LO chunk) {
+  return DynamicPolicy(0, static_cast<std::size_t>(n))
+      .set_chunk_size(static_cast<int>(chunk));
+}
+#elif defined(OMEGA_H_USE_OPENMP)
+/* without Kokkos, the OpenMP backend splits [0,n) into one contiguous
+   chunk per thread. reductions and scans use the same chunks,
+   so partial results are joined in a fixed order and
+   the answers only depend on the number of threads. */
+inline void get_thread_range(
+    LO n, int thread, int nthreads, LO* begin, LO* end) {
+  auto quot = n / nthreads;
+  auto rem = n % nthreads;
+  *begin = thread * quot + ((thread < rem) ? thread : rem);
+  *end = *begin + quot + ((thread < rem) ? 1 : 0);
+}
+
+/* the remaining part of one thread's range for parallel_for_dynamic.
+   the owner and thieves both take chunks from the front with an
+   atomic increment, the padding keeps ranges on separate cache lines */
+struct StealableRange {
+  std::atomic<LO> next;
+  LO end;
+  char padding[64 - sizeof(std::atomic<LO>) - sizeof(LO)];
+};
+
+template <typename T>
+inline bool run_stolen_chunk(StealableRange& range, LO chunk, T const& f) {
+  if (range.next.load(std::memory_order_relaxed) >= range.end) return false;
+  auto begin = range.next.fetch_add(chunk, std::memory_order_relaxed);
+  if (begin >= range.end) return false;
+  auto end = (begin + chunk < range.end) ? (begin + chunk) : range.end;
+  for (LO i = begin; i < end; ++i) f(i);
+  return true;
+}
 #endif
 
 template <typename T>
 void parallel_for(LO n, T const& f, std::string const& name = "") {
 #ifdef OMEGA_H_USE_KOKKOSCORE
   if (n > 0) Kokkos::parallel_for(policy(n), f, name);
+#elif defined(OMEGA_H_USE_OPENMP)
+  begin_code(name);
+#pragma omp parallel for schedule(static)
+  for (LO i = 0; i < n; ++i) f(i);
+  end_code();
 #else
   begin_code(name);
   for (LO i = 0; i < n; ++i) f(i);
@@ -25,6 +75,46 @@ void parallel_for(LO n, T const& f, std::string const& name = "") {
 #endif
 }
 
+/* a parallel_for for loops whose iterations do very different amounts
+   of work (cavities, edge loops). each thread starts on its own
+   contiguous range and, once that is exhausted, steals chunks of
+   (chunk) iterations from the other threads' ranges. */
+template <typename T>
+void parallel_for_dynamic(
+    LO n, T const& f, std::string const& name = "", LO chunk = 16) {
+#ifdef OMEGA_H_USE_KOKKOSCORE
+  if (n > 0) Kokkos::parallel_for(dynamic_policy(n, chunk), f, name);
+#elif defined(OMEGA_H_USE_OPENMP)
+  begin_code(name);
+  std::vector<StealableRange> ranges(
+      static_cast<std::size_t>(omp_get_max_threads()));
+#pragma omp parallel
+  {
+    int thread = omp_get_thread_num();
+    int nthreads = omp_get_num_threads();
+    auto& own = ranges[std::size_t(thread)];
+    LO begin, end;
+    get_thread_range(n, thread, nthreads, &begin, &end);
+    own.next.store(begin, std::memory_order_relaxed);
+    own.end = end;
+#pragma omp barrier
+    while (run_stolen_chunk(own, chunk, f))
+      ;
+    for (int i = 1; i < nthreads; ++i) {
+      auto& victim = ranges[std::size_t((thread + i) % nthreads)];
+      while (run_stolen_chunk(victim, chunk, f))
+        ;
+    }
+  }
+  end_code();
+#else
+  (void)chunk;
+  begin_code(name);
+  for (LO i = 0; i < n; ++i) f(i);
+  end_code();
+#endif
+}
+
 template <typename T>
 typename T::value_type parallel_reduce(
     LO n, T f, std::string const& name = "") {
@@ -33,6 +123,24 @@ typename T::value_type parallel_reduce(
   f.init(result);
 #ifdef OMEGA_H_USE_KOKKOSCORE
   if (n > 0) Kokkos::parallel_reduce(name, policy(n), f, result);
+#elif defined(OMEGA_H_USE_OPENMP)
+  begin_code(name);
+  std::vector<VT> partials(static_cast<std::size_t>(omp_get_max_threads()));
+  int nthreads = 1;
+#pragma omp parallel
+  {
+    int thread = omp_get_thread_num();
+#pragma omp single
+    nthreads = omp_get_num_threads();
+    LO begin, end;
+    get_thread_range(n, thread, nthreads, &begin, &end);
+    VT local;
+    f.init(local);
+    for (LO i = begin; i < end; ++i) f(i, local);
+    partials[std::size_t(thread)] = local;
+  }
+  for (int t = 0; t < nthreads; ++t) f.join(result, partials[std::size_t(t)]);
+  end_code();
 #else
   begin_code(name);
   for (LO i = 0; i < n; ++i) f(i, result);
@@ -45,6 +153,30 @@ template <typename T>
 void parallel_scan(LO n, T f, std::string const& name = "") {
 #ifdef OMEGA_H_USE_KOKKOSCORE
   if (n > 0) Kokkos::parallel_scan(policy(n), f, name);
+#elif defined(OMEGA_H_USE_OPENMP)
+  /* two passes over the same chunks: the first computes each chunk's
+     total without writing, the second starts each chunk from the
+     join of all the totals to its left and does the final pass */
+  typedef typename T::value_type VT;
+  begin_code(name);
+  std::vector<VT> partials(static_cast<std::size_t>(omp_get_max_threads()));
+#pragma omp parallel
+  {
+    int thread = omp_get_thread_num();
+    int nthreads = omp_get_num_threads();
+    LO begin, end;
+    get_thread_range(n, thread, nthreads, &begin, &end);
+    VT local;
+    f.init(local);
+    for (LO i = begin; i < end; ++i) f(i, local, false);
+    partials[std::size_t(thread)] = local;
+#pragma omp barrier
+    VT update;
+    f.init(update);
+    for (int t = 0; t < thread; ++t) f.join(update, partials[std::size_t(t)]);
+    for (LO i = begin; i < end; ++i) f(i, update, true);
+  }
+  end_code();
 #else
   typedef typename T::value_type VT;
   begin_code(name);
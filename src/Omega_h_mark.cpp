@@ -42,6 +42,21 @@ Read<I8> mark_down(
   return low_marks;
 }
 
+Read<I8> mark_local_closure(Mesh* mesh, Int low_dim, Read<I8> elems) {
+  if (low_dim == mesh->dim()) return elems;
+  auto l2e = mesh->ask_up(low_dim, mesh->dim());
+  auto l2le = l2e.a2ab;
+  auto le2e = l2e.ab2b;
+  Write<I8> marks(mesh->nents(low_dim), 0);
+  auto f = OMEGA_H_LAMBDA(LO l) {
+    for (auto le = l2le[l]; le < l2le[l + 1]; ++le) {
+      if (elems[le2e[le]]) marks[l] = 1;
+    }
+  };
+  parallel_for(mesh->nents(low_dim), f, "mark_local_closure");
+  return marks;
+}
+
 Read<I8> mark_up(Mesh* mesh, Int low_dim, Int high_dim, Read<I8> low_marked) {
   auto l2h = mesh->ask_down(high_dim, low_dim);
   auto deg = element_degree(mesh->family(), high_dim, low_dim);
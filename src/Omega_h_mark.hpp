@@ -11,6 +11,9 @@ class Mesh;
 
 Read<I8> mark_down(
     Mesh* mesh, Int high_dim, Int low_dim, Read<I8> marked_highs);
+/* like mark_down() from the elements, but only looks at
+   local elements, so copies of an entity may disagree */
+Read<I8> mark_local_closure(Mesh* mesh, Int low_dim, Read<I8> elems);
 Read<I8> mark_up(Mesh* mesh, Int low_dim, Int high_dim, Read<I8> low_marked);
 Read<I8> mark_adj(Mesh* mesh, Int from_dim, Int to_dim, Read<I8> from_marked);
 Read<I8> mark_up_all(
@@ -10,12 +10,14 @@
 #include "Omega_h_control.hpp"
 #include "Omega_h_element.hpp"
 #include "Omega_h_ghost.hpp"
+#include "Omega_h_hilbert.hpp"
 #include "Omega_h_inertia.hpp"
 #include "Omega_h_loop.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mark.hpp"
 #include "Omega_h_migrate.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_rebalance.hpp"
 #include "Omega_h_shape.hpp"
 #include "Omega_h_timer.hpp"
 
@@ -55,11 +57,15 @@ void Mesh::set_comm(CommPtr const& new_comm) {
   /* if some ranks already have mesh data, their
      parallel info needs updating, we'll do this
      by using the old Dist to set new owners */
-  if (0 < nnew_had_comm && library_->world()->size() > 1) {
+  if (0 < nnew_had_comm &&
+      (library_->world()->size() > 1 || new_comm->size() > 1)) {
     for (Int d = 0; d <= dim(); ++d) {
       auto dist = ask_dist(d);
       dist.change_comm(new_comm);
       owners_[d].ranks = dist.items2ranks();
+      /* keep the graph communicators that change_comm() built */
+      dists_[d] = std::make_shared<Dist>(dist);
+      inverse_dists_[d] = DistPtr();
     }
   }
   comm_ = new_comm;
@@ -85,6 +91,16 @@ void Mesh::set_ents(Int ent_dim, Adj down) {
   add_adj(ent_dim, ent_dim - 1, down);
 }
 
+/* lets callers which can update an upward adjacency cheaply
+   (see modify_ents()) avoid its full derivation */
+void Mesh::set_up(Int from, Int to, Adj up) {
+  check_dim2(from);
+  check_dim2(to);
+  OMEGA_H_CHECK(from < to);
+  OMEGA_H_CHECK(!has_adj(from, to));
+  add_adj(from, to, up);
+}
+
 CommPtr Mesh::comm() const { return comm_; }
 
 LO Mesh::nents(Int ent_dim) const {
@@ -123,6 +139,7 @@ void Mesh::add_tag(Int ent_dim, std::string const& name, Int ncomps) {
   OMEGA_H_CHECK(ncomps >= 0);
   OMEGA_H_CHECK(ncomps <= Int(INT8_MAX));
   OMEGA_H_CHECK(tags_[ent_dim].size() < size_t(INT8_MAX));
+  tag_indices_[ent_dim][name] = tags_[ent_dim].size();
   tags_[ent_dim].push_back(TagPtr(new Tag<T>(name, ncomps)));
 }
 
@@ -136,20 +153,37 @@ void Mesh::add_tag(Int ent_dim, std::string const& name, Int ncomps,
 template <typename T>
 void Mesh::set_tag(
     Int ent_dim, std::string const& name, Read<T> array, bool internal) {
-  if (!has_tag(ent_dim, name)) {
+  auto it = has_ents(ent_dim) ? tag_iter(ent_dim, name) : tags_[ent_dim].end();
+  if (it == tags_[ent_dim].end()) {
     Omega_h_fail("set_tag(%s, %s): tag doesn't exist (use add_tag first)\n",
         topological_plural_name(family(), ent_dim), name.c_str());
   }
-  Tag<T>* tag = as<T>(tag_iter(ent_dim, name)->get());
+  Tag<T>* tag = as<T>(it->get());
   OMEGA_H_CHECK(array.size() == nents(ent_dim) * tag->ncomps());
   /* internal typically indicates migration/adaptation/file reading,
      when we do not want any invalidation to take place.
      the invalidation is there to prevent users changing coordinates
-     etc. without updating dependent fields */
-  if (!internal) react_to_set_tag(ent_dim, name);
+     etc. without updating dependent fields.
+     setting a tag to the array it already holds changes nothing,
+     and an array not loaded yet is not loaded just to compare it */
+  auto is_same_array = tag->is_loaded() && tag->array().exists() &&
+                       array.exists() &&
+                       tag->array().data() == array.data();
+  if (!internal && !is_same_array) react_to_set_tag(ent_dim, name);
   tag->set_array(array);
 }
 
+template <typename T>
+void Mesh::add_lazy_tag(Int ent_dim, std::string const& name, Int ncomps,
+    std::function<Read<T>()> loader) {
+  add_tag<T>(ent_dim, name, ncomps);
+  as<T>(tag_iter(ent_dim, name)->get())->set_loader(loader);
+}
+
+/* the quantities cached by ask_lengths(), ask_qualities() and
+   ask_sizes() are stored as tags which are updated for newly produced
+   entities only by the transfer functions during adaptation.
+   they depend on vertex tags, and are removed whenever those change. */
 void Mesh::react_to_set_tag(Int ent_dim, std::string const& name) {
   /* hardcoded cache invalidations */
   if ((ent_dim == VERT) && ((name == "coordinates") || (name == "metric"))) {
@@ -163,11 +197,12 @@ void Mesh::react_to_set_tag(Int ent_dim, std::string const& name) {
 
 TagBase const* Mesh::get_tagbase(Int ent_dim, std::string const& name) const {
   check_dim2(ent_dim);
-  if (!has_tag(ent_dim, name)) {
+  auto it = tag_iter(ent_dim, name);
+  if (it == tags_[ent_dim].end()) {
     Omega_h_fail("get_tagbase(%s, %s): doesn't exist\n",
         topological_plural_name(family(), ent_dim), name.c_str());
   }
-  return tag_iter(ent_dim, name)->get();
+  return it->get();
 }
 
 template <typename T>
@@ -183,8 +218,15 @@ Read<T> Mesh::get_array(Int ent_dim, std::string const& name) const {
 void Mesh::remove_tag(Int ent_dim, std::string const& name) {
   if (!has_tag(ent_dim, name)) return;
   check_dim2(ent_dim);
-  OMEGA_H_CHECK(has_tag(ent_dim, name));
-  tags_[ent_dim].erase(tag_iter(ent_dim, name));
+  auto it = tag_iter(ent_dim, name);
+  auto i = std::size_t(it - tags_[ent_dim].begin());
+  tags_[ent_dim].erase(it);
+  auto& indices = tag_indices_[ent_dim];
+  indices.erase(name);
+  for (; i < tags_[ent_dim].size(); ++i) indices[tags_[ent_dim][i]->name()] = i;
+  /* otherwise a cache could outlive its inputs if they are
+     then added again with internal=true */
+  react_to_set_tag(ent_dim, name);
 }
 
 bool Mesh::has_tag(Int ent_dim, std::string const& name) const {
@@ -244,22 +286,21 @@ Graph Mesh::ask_star(Int ent_dim) {
 
 Graph Mesh::ask_dual() { return ask_adj(dim(), dim()); }
 
-struct HasName {
-  std::string const& name_;
-  HasName(std::string const& name) : name_(name) {}
-  bool operator()(std::shared_ptr<TagBase> const& a) {
-    return a->name() == name_;
-  }
-};
-
+/* tags are looked up by name very often (every get_array() call),
+   so instead of comparing against each tag name we keep a hashed
+   index of their positions */
 Mesh::TagIter Mesh::tag_iter(Int ent_dim, std::string const& name) {
-  return std::find_if(
-      tags_[ent_dim].begin(), tags_[ent_dim].end(), HasName(name));
+  auto& indices = tag_indices_[ent_dim];
+  auto it = indices.find(name);
+  if (it == indices.end()) return tags_[ent_dim].end();
+  return tags_[ent_dim].begin() + TagVector::difference_type(it->second);
 }
 
 Mesh::TagCIter Mesh::tag_iter(Int ent_dim, std::string const& name) const {
-  return std::find_if(
-      tags_[ent_dim].begin(), tags_[ent_dim].end(), HasName(name));
+  auto& indices = tag_indices_[ent_dim];
+  auto it = indices.find(name);
+  if (it == indices.end()) return tags_[ent_dim].end();
+  return tags_[ent_dim].begin() + TagVector::difference_type(it->second);
 }
 
 void Mesh::check_dim(Int ent_dim) const {
@@ -394,6 +435,7 @@ void Mesh::set_owners(Int ent_dim, Remotes owners) {
   OMEGA_H_CHECK(nents(ent_dim) == owners.idxs.size());
   owners_[ent_dim] = owners;
   dists_[ent_dim] = DistPtr();
+  inverse_dists_[ent_dim] = DistPtr();
 }
 
 Remotes Mesh::ask_owners(Int ent_dim) {
@@ -420,6 +462,14 @@ Dist Mesh::ask_dist(Int ent_dim) {
   return *(dists_[ent_dim]);
 }
 
+Dist Mesh::ask_inverse_dist(Int ent_dim) {
+  if (!inverse_dists_[ent_dim]) {
+    auto owners2copies = ask_dist(ent_dim).invert();
+    inverse_dists_[ent_dim] = std::make_shared<Dist>(owners2copies);
+  }
+  return *(inverse_dists_[ent_dim]);
+}
+
 Omega_h_Parting Mesh::parting() const {
   OMEGA_H_CHECK(parting_ != -1);
   return Omega_h_Parting(parting_);
@@ -484,18 +534,11 @@ void Mesh::balance(bool predictive) {
   auto ecoords =
       average_field(this, dim(), LOs(nelems(), 0, 1), dim(), coords());
   if (dim() < 3) ecoords = resize_vectors(ecoords, dim(), 3);
-  Reals masses;
+  auto masses = get_balance_masses(this, predictive);
   Real abs_tol;
   if (predictive) {
-    masses =
-        get_expected_nelems_per_elem(this, get_array<Real>(VERT, "metric"));
-    /* average between input mesh weight (1.0)
-       and predicted output mesh weight */
-    masses = add_to_each(masses, 1.);
-    masses = multiply_each_by(masses, 1. / 2.);
     abs_tol = max2(0.0, get_max(comm_, masses));
   } else {
-    masses = Reals(nelems(), 1);
     abs_tol = 1.0;
   }
   abs_tol *= 2.0;  // fudge factor ?
@@ -510,6 +553,21 @@ void Mesh::balance(bool predictive) {
   migrate_mesh(this, sorted_new2owners, OMEGA_H_ELEM_BASED, false);
 }
 
+void Mesh::balance_by_hilbert(bool predictive) {
+  if (comm_->size() == 1) return;
+  set_parting(OMEGA_H_ELEM_BASED);
+  auto ecoords =
+      average_field(this, dim(), LOs(nelems(), 0, 1), dim(), coords());
+  auto masses = get_balance_masses(this, predictive);
+  auto parts = hilbert::partition_coords(comm_, ecoords, dim(), masses);
+  Dist owners2new;
+  owners2new.set_parent_comm(comm_);
+  owners2new.set_dest_ranks(parts);
+  owners2new.set_roots2items(LOs(nelems() + 1, 0, 1));
+  owners2new.set_dest_globals(this->globals(dim()));
+  migrate_mesh(this, owners2new.invert(), OMEGA_H_ELEM_BASED, false);
+}
+
 Graph Mesh::ask_graph(Int from, Int to) {
   if (to > from) {
     return ask_up(from, to);
@@ -526,7 +584,13 @@ Graph Mesh::ask_graph(Int from, Int to) {
 template <typename T>
 Read<T> Mesh::sync_array(Int ent_dim, Read<T> a, Int width) {
   if (!could_be_shared(ent_dim)) return a;
-  return ask_dist(ent_dim).invert().exch(a, width);
+  return ask_inverse_dist(ent_dim).exch(a, width);
+}
+
+template <typename T>
+DistRequest<T> Mesh::sync_array_begin(Int ent_dim, Read<T> a, Int width) {
+  if (!could_be_shared(ent_dim)) return DistRequest<T>(a);
+  return ask_inverse_dist(ent_dim).exch_begin(a, width);
 }
 
 template <typename T>
@@ -583,6 +647,46 @@ void Mesh::sync_tag(Int ent_dim, std::string const& name) {
   }
 }
 
+template <typename T>
+static void set_synced_tag(Mesh* mesh, Int ent_dim, TagBase const* tag) {
+  auto array = as<T>(tag)->array();
+  if (mesh->has_tag(ent_dim, tag->name())) {
+    mesh->set_tag(ent_dim, tag->name(), array);
+  } else {
+    mesh->add_tag(ent_dim, tag->name(), tag->ncomps(), array, true);
+  }
+}
+
+void Mesh::sync_tags(TagSet const& tags) {
+  /* everything is exchanged before anything is set. vertex tags are
+     set first, since setting some of them removes cached tags of
+     higher dimensions, which are then put back if they were synced
+     too, as they agree with the synced vertex tags */
+  std::vector<std::vector<TagPtr>> new_tags(size_t(dim() + 1));
+  for (Int ent_dim = 0; ent_dim <= dim(); ++ent_dim) {
+    if (tags[size_t(ent_dim)].empty()) continue;
+    if (!could_be_shared(ent_dim)) continue;
+    std::vector<TagBase const*> old_tags;
+    for (auto& name : tags[size_t(ent_dim)]) {
+      old_tags.push_back(get_tagbase(ent_dim, name));
+    }
+    new_tags[size_t(ent_dim)] = exch_tags(ask_inverse_dist(ent_dim), old_tags);
+  }
+  for (Int ent_dim = 0; ent_dim <= dim(); ++ent_dim) {
+    for (auto& tag : new_tags[size_t(ent_dim)]) {
+      if (is<I8>(tag.get())) {
+        set_synced_tag<I8>(this, ent_dim, tag.get());
+      } else if (is<I32>(tag.get())) {
+        set_synced_tag<I32>(this, ent_dim, tag.get());
+      } else if (is<I64>(tag.get())) {
+        set_synced_tag<I64>(this, ent_dim, tag.get());
+      } else if (is<Real>(tag.get())) {
+        set_synced_tag<Real>(this, ent_dim, tag.get());
+      }
+    }
+  }
+}
+
 void Mesh::reduce_tag(Int ent_dim, std::string const& name, Omega_h_Op op) {
   auto tagbase = get_tagbase(ent_dim, name);
   switch (tagbase->type()) {
@@ -723,7 +827,11 @@ void ask_for_mesh_tags(Mesh* mesh, TagSet const& tags) {
       Read<T> array, bool internal);                                           \
   template void Mesh::set_tag(                                                 \
       Int dim, std::string const& name, Read<T> array, bool internal);         \
+  template void Mesh::add_lazy_tag(Int dim, std::string const& name,           \
+      Int ncomps, std::function<Read<T>()> loader);                            \
   template Read<T> Mesh::sync_array(Int ent_dim, Read<T> a, Int width);        \
+  template DistRequest<T> Mesh::sync_array_begin(                              \
+      Int ent_dim, Read<T> a, Int width);                                      \
   template Read<T> Mesh::owned_array(Int ent_dim, Read<T> a, Int width);       \
   template Read<T> Mesh::sync_subset_array(                                    \
       Int ent_dim, Read<T> a_data, LOs a2e, T default_val, Int width);         \
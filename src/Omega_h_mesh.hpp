@@ -2,6 +2,7 @@
 #define OMEGA_H_MESH_HPP
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <Omega_h_adj.hpp>
@@ -25,6 +26,7 @@ class Mesh {
   void set_dim(Int dim_in);
   void set_verts(LO nverts_in);
   void set_ents(Int ent_dim, Adj down);
+  void set_up(Int from, Int to, Adj up);
   CommPtr comm() const;
   Omega_h_Parting parting() const;
   inline Int dim() const {
@@ -47,6 +49,10 @@ class Mesh {
   template <typename T>
   void set_tag(
       Int dim, std::string const& name, Read<T> array, bool internal = false);
+  /* adds a tag whose array is made by (loader) when first asked for */
+  template <typename T>
+  void add_lazy_tag(Int dim, std::string const& name, Int ncomps,
+      std::function<Read<T>()> loader);
   TagBase const* get_tagbase(Int dim, std::string const& name) const;
   template <typename T>
   Tag<T> const* get_tag(Int dim, std::string const& name) const;
@@ -76,6 +82,8 @@ class Mesh {
   typedef std::vector<TagPtr> TagVector;
   typedef TagVector::iterator TagIter;
   typedef TagVector::const_iterator TagCIter;
+  /* maps tag names to their position in tags_[dim] */
+  typedef std::unordered_map<std::string, std::size_t> TagIndex;
   TagIter tag_iter(Int dim, std::string const& name);
   TagCIter tag_iter(Int dim, std::string const& name) const;
   void check_dim(Int dim) const;
@@ -91,9 +99,11 @@ class Mesh {
   Int nghost_layers_;
   LO nents_[DIMS];
   TagVector tags_[DIMS];
+  TagIndex tag_indices_[DIMS];
   AdjPtr adjs_[DIMS][DIMS];
   Remotes owners_[DIMS];
   DistPtr dists_[DIMS];
+  DistPtr inverse_dists_[DIMS];
   RibPtr rib_hints_;
   Library* library_;
 
@@ -109,13 +119,26 @@ class Mesh {
   Remotes ask_owners(Int dim);
   Read<I8> owned(Int dim);
   Dist ask_dist(Int dim);
+  /* the inverse of ask_dist(), from owners to all their copies.
+     like ask_dist(), it is cached until the owners change */
+  Dist ask_inverse_dist(Int dim);
   Int nghost_layers() const;
   void set_parting(Omega_h_Parting parting_in, Int nlayers, bool verbose);
   void set_parting(Omega_h_Parting parting_in, bool verbose = false);
   void balance(bool predictive = false);
+  /* like balance(), but cuts a Hilbert curve through the element
+     centroids instead of bisecting them, which is cheaper and
+     keeps the parts of a slowly changing mesh in place */
+  void balance_by_hilbert(bool predictive = false);
   Graph ask_graph(Int from, Int to);
   template <typename T>
   Read<T> sync_array(Int ent_dim, Read<T> a, Int width);
+  /* starts sync_array() and returns before the ghost values arrive.
+     values of owned entities in (a) are already final, so work
+     that only reads those can overlap the exchange before
+     wait() is called on the returned request */
+  template <typename T>
+  DistRequest<T> sync_array_begin(Int ent_dim, Read<T> a, Int width);
   template <typename T>
   Read<T> sync_subset_array(
       Int ent_dim, Read<T> a_data, LOs a2e, T default_val, Int width);
@@ -124,6 +147,8 @@ class Mesh {
   template <typename T>
   Read<T> owned_array(Int ent_dim, Read<T> a, Int width);
   void sync_tag(Int dim, std::string const& name);
+  /* syncs all the given tags with one exchange per dimension */
+  void sync_tags(TagSet const& tags);
   void reduce_tag(Int dim, std::string const& name, Omega_h_Op op);
   bool operator==(Mesh& other);
   Real min_quality();
@@ -161,7 +186,11 @@ void reorder_by_globals(Mesh* mesh);
       Int ncomps, Read<T> array, bool internal);                               \
   extern template void Mesh::set_tag(                                          \
       Int dim, std::string const& name, Read<T> array, bool internal);         \
+  extern template void Mesh::add_lazy_tag(Int dim, std::string const& name,    \
+      Int ncomps, std::function<Read<T>()> loader);                            \
   extern template Read<T> Mesh::sync_array(Int ent_dim, Read<T> a, Int width); \
+  extern template DistRequest<T> Mesh::sync_array_begin(                       \
+      Int ent_dim, Read<T> a, Int width);                                      \
   extern template Read<T> Mesh::owned_array(                                   \
       Int ent_dim, Read<T> a, Int width);                                      \
   extern template Read<T> Mesh::sync_subset_array(                             \
@@ -191,11 +191,12 @@ void axes_from_metric_field(Mesh* mesh, std::string const& metric_name,
 
 template <Int mesh_dim, Int metric_dim>
 static Reals limit_gradation_once_tmpl(
-    Mesh* mesh, Reals values, Real max_rate) {
+    Mesh* mesh, Reals values, Real max_rate, LOs cands2verts) {
   auto v2v = mesh->ask_star(VERT);
   auto coords = mesh->coords();
-  auto out = Write<Real>(mesh->nverts() * symm_ncomps(metric_dim));
-  auto f = OMEGA_H_LAMBDA(LO v) {
+  auto out = deep_copy(values);
+  auto f = OMEGA_H_LAMBDA(LO cand) {
+    auto v = cands2verts[cand];
     auto m = get_symm<metric_dim>(values, v);
     auto x = get_vector<mesh_dim>(coords, v);
     for (auto vv = v2v.a2ab[v]; vv < v2v.a2ab[v + 1]; ++vv) {
@@ -211,47 +212,94 @@ static Reals limit_gradation_once_tmpl(
     }
     set_symm(out, v, m);
   };
-  parallel_for(mesh->nverts(), f, "limit_metric_gradation");
+  parallel_for(cands2verts.size(), f, "limit_metric_gradation");
   values = Reals(out);
   values = mesh->sync_array(VERT, values, symm_ncomps(metric_dim));
   return values;
 }
 
-static Reals limit_gradation_once(Mesh* mesh, Reals values, Real max_rate) {
+static Reals limit_gradation_once(
+    Mesh* mesh, Reals values, Real max_rate, LOs cands2verts) {
   auto metric_dim = get_metrics_dim(mesh->nverts(), values);
   if (mesh->dim() == 3 && metric_dim == 3) {
-    return limit_gradation_once_tmpl<3, 3>(mesh, values, max_rate);
+    return limit_gradation_once_tmpl<3, 3>(
+        mesh, values, max_rate, cands2verts);
   } else if (mesh->dim() == 2 && metric_dim == 2) {
-    return limit_gradation_once_tmpl<2, 2>(mesh, values, max_rate);
+    return limit_gradation_once_tmpl<2, 2>(
+        mesh, values, max_rate, cands2verts);
   } else if (mesh->dim() == 3 && metric_dim == 1) {
-    return limit_gradation_once_tmpl<3, 1>(mesh, values, max_rate);
+    return limit_gradation_once_tmpl<3, 1>(
+        mesh, values, max_rate, cands2verts);
   } else if (mesh->dim() == 2 && metric_dim == 1) {
-    return limit_gradation_once_tmpl<2, 1>(mesh, values, max_rate);
+    return limit_gradation_once_tmpl<2, 1>(
+        mesh, values, max_rate, cands2verts);
   } else if (mesh->dim() == 1) {
-    return limit_gradation_once_tmpl<1, 1>(mesh, values, max_rate);
+    return limit_gradation_once_tmpl<1, 1>(
+        mesh, values, max_rate, cands2verts);
   }
   OMEGA_H_NORETURN(Reals());
 }
 
+/* marks vertices whose metric changed at all (1)
+   or by more than (tol) (2) */
+static Read<I8> mark_changed_metrics(
+    LO nverts, Reals old_values, Reals new_values, Real tol) {
+  auto ncomps = divide_no_remainder(new_values.size(), nverts);
+  Write<I8> out(nverts);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    I8 change = 0;
+    for (Int c = 0; c < ncomps; ++c) {
+      auto a = old_values[v * ncomps + c];
+      auto b = new_values[v * ncomps + c];
+      if (a != b) change = max2(change, I8(1));
+      if (!are_close(a, b, tol, EPSILON)) change = 2;
+    }
+    out[v] = change;
+  };
+  parallel_for(nverts, f, "mark_changed_metrics");
+  return out;
+}
+
+/* this is a label-correcting iteration: limiting a vertex
+   can only give a different result than it did last time
+   if it or one of its neighbors has changed since then,
+   so after the first step over all vertices, each step only
+   visits those vertices (the front).
+   this computes exactly the same values as limiting all
+   vertices in every step, and stops at the same step.
+   each step costs one synchronization and one reduction,
+   and its heavy work is proportional to the front. */
 Reals limit_metric_gradation(
     Mesh* mesh, Reals values, Real max_rate, Real tol, bool verbose) {
   OMEGA_H_CHECK(mesh->owners_have_all_upward(VERT));
   OMEGA_H_CHECK(max_rate > 0.0);
   auto comm = mesh->comm();
-  Reals values2 = values;
+  auto nverts = mesh->nverts();
+  auto v2v = mesh->ask_star(VERT);
+  auto cands2verts = LOs(nverts, 0, 1);
+  GO nvisited = 0;
   Int i = 0;
-  do {
-    values = values2;
-    values2 = limit_gradation_once(mesh, values, max_rate);
+  while (true) {
+    auto values2 = limit_gradation_once(mesh, values, max_rate, cands2verts);
+    if (verbose) {
+      nvisited += comm->allreduce(GO(cands2verts.size()), OMEGA_H_SUM);
+    }
     ++i;
-    if (verbose && can_print(mesh) && i > 0 && i % 50 == 0) {
+    auto verts_did_change = mark_changed_metrics(nverts, values, values2, tol);
+    values = values2;
+    if (get_max(comm, verts_did_change) != 2) break;
+    auto verts_are_cands = lor_each(verts_did_change,
+        graph_reduce(v2v, verts_did_change, 1, OMEGA_H_MAX));
+    cands2verts = collect_marked(verts_are_cands);
+    if (verbose && can_print(mesh) && i % 50 == 0) {
       std::cout << "warning: gradation limiting is up to step " << i << '\n';
     }
-  } while (!comm->reduce_and(are_close(values, values2, tol)));
+  }
   if (verbose && can_print(mesh)) {
-    std::cout << "limited gradation in " << i << " steps\n";
+    std::cout << "limited gradation in " << i << " steps, " << nvisited
+              << " vertex visits\n";
   }
-  return values2;
+  return values;
 }
 
 template <Int metric_dim>
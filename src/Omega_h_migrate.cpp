@@ -123,28 +123,152 @@ void push_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
   end_code();
 }
 
+template <typename T>
+static Read<T> tag_array(TagBase const* tag) {
+  return as<T>(tag)->array();
+}
+
+static LO tag_size(TagBase const* tag) {
+  switch (tag->type()) {
+    case OMEGA_H_I8:
+      return tag_array<I8>(tag).size();
+    case OMEGA_H_I32:
+      return tag_array<I32>(tag).size();
+    case OMEGA_H_I64:
+      return tag_array<I64>(tag).size();
+    case OMEGA_H_F64:
+      return tag_array<Real>(tag).size();
+  }
+  return -1;
+}
+
+static Int tag_value_bytes(TagBase const* tag) {
+  switch (tag->type()) {
+    case OMEGA_H_I8:
+      return Int(sizeof(I8));
+    case OMEGA_H_I32:
+      return Int(sizeof(I32));
+    case OMEGA_H_I64:
+      return Int(sizeof(I64));
+    case OMEGA_H_F64:
+      return Int(sizeof(Real));
+  }
+  return -1;
+}
+
+template <typename T>
+static void pack_tag(TagBase const* tag, LO nents, Write<I8> rows,
+    Int row_bytes, Int offset) {
+  auto array = tag_array<T>(tag);
+  auto ncomps = tag->ncomps();
+  auto nbytes = ncomps * Int(sizeof(T));
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto from = reinterpret_cast<I8 const*>(&array[i * ncomps]);
+    auto to = &rows[i * row_bytes + offset];
+    for (Int j = 0; j < nbytes; ++j) to[j] = from[j];
+  };
+  parallel_for(nents, f, "pack_tag");
+}
+
+template <typename T>
+static std::shared_ptr<TagBase> unpack_tag(TagBase const* tag, LO nents,
+    Read<I8> rows, Int row_bytes, Int offset) {
+  auto ncomps = tag->ncomps();
+  auto nbytes = ncomps * Int(sizeof(T));
+  Write<T> array(nents * ncomps);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto from = &rows[i * row_bytes + offset];
+    auto to = reinterpret_cast<I8*>(&array[i * ncomps]);
+    for (Int j = 0; j < nbytes; ++j) to[j] = from[j];
+  };
+  parallel_for(nents, f, "unpack_tag");
+  auto out = std::make_shared<Tag<T>>(tag->name(), ncomps);
+  out->set_array(array);
+  return out;
+}
+
+std::vector<std::shared_ptr<TagBase>> exch_tags(
+    Dist const& dist, std::vector<TagBase const*> const& tags) {
+  std::vector<std::shared_ptr<TagBase>> out;
+  if (tags.empty()) return out;
+  begin_code("exch_tags");
+  auto nsrcs = divide_no_remainder(tag_size(tags[0]), tags[0]->ncomps());
+  Int row_bytes = 0;
+  for (auto tag : tags) {
+    OMEGA_H_CHECK(tag_size(tag) == nsrcs * tag->ncomps());
+    row_bytes += tag->ncomps() * tag_value_bytes(tag);
+  }
+  Write<I8> src_rows(nsrcs * row_bytes);
+  Int offset = 0;
+  for (auto tag : tags) {
+    switch (tag->type()) {
+      case OMEGA_H_I8:
+        pack_tag<I8>(tag, nsrcs, src_rows, row_bytes, offset);
+        break;
+      case OMEGA_H_I32:
+        pack_tag<I32>(tag, nsrcs, src_rows, row_bytes, offset);
+        break;
+      case OMEGA_H_I64:
+        pack_tag<I64>(tag, nsrcs, src_rows, row_bytes, offset);
+        break;
+      case OMEGA_H_F64:
+        pack_tag<Real>(tag, nsrcs, src_rows, row_bytes, offset);
+        break;
+    }
+    offset += tag->ncomps() * tag_value_bytes(tag);
+  }
+  auto dest_rows = dist.exch(Read<I8>(src_rows), row_bytes);
+  auto ndests = divide_no_remainder(dest_rows.size(), row_bytes);
+  offset = 0;
+  for (auto tag : tags) {
+    switch (tag->type()) {
+      case OMEGA_H_I8:
+        out.push_back(
+            unpack_tag<I8>(tag, ndests, dest_rows, row_bytes, offset));
+        break;
+      case OMEGA_H_I32:
+        out.push_back(
+            unpack_tag<I32>(tag, ndests, dest_rows, row_bytes, offset));
+        break;
+      case OMEGA_H_I64:
+        out.push_back(
+            unpack_tag<I64>(tag, ndests, dest_rows, row_bytes, offset));
+        break;
+      case OMEGA_H_F64:
+        out.push_back(
+            unpack_tag<Real>(tag, ndests, dest_rows, row_bytes, offset));
+        break;
+    }
+    offset += tag->ncomps() * tag_value_bytes(tag);
+  }
+  end_code();
+  return out;
+}
+
 void push_tags(Mesh const* old_mesh, Mesh* new_mesh, Int ent_dim,
     Dist old_owners2new_ents) {
   begin_code("push_tags");
   OMEGA_H_CHECK(old_owners2new_ents.nroots() == old_mesh->nents(ent_dim));
+  std::vector<TagBase const*> old_tags;
   for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
-    auto tag = old_mesh->get_tag(ent_dim, i);
-    if (is<I8>(tag)) {
-      auto array = as<I8>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I8>(ent_dim, tag->name(), tag->ncomps(), array, true);
-    } else if (is<I32>(tag)) {
-      auto array = as<I32>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I32>(ent_dim, tag->name(), tag->ncomps(), array, true);
-    } else if (is<I64>(tag)) {
-      auto array = as<I64>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I64>(ent_dim, tag->name(), tag->ncomps(), array, true);
-    } else if (is<Real>(tag)) {
-      auto array = as<Real>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<Real>(ent_dim, tag->name(), tag->ncomps(), array, true);
+    old_tags.push_back(old_mesh->get_tag(ent_dim, i));
+  }
+  auto new_tags = exch_tags(old_owners2new_ents, old_tags);
+  for (auto& tag : new_tags) {
+    auto name = tag->name();
+    auto ncomps = tag->ncomps();
+    if (is<I8>(tag.get())) {
+      auto array = as<I8>(tag.get())->array();
+      new_mesh->add_tag<I8>(ent_dim, name, ncomps, array, true);
+    } else if (is<I32>(tag.get())) {
+      auto array = as<I32>(tag.get())->array();
+      new_mesh->add_tag<I32>(ent_dim, name, ncomps, array, true);
+    } else if (is<I64>(tag.get())) {
+      auto array = as<I64>(tag.get())->array();
+      new_mesh->add_tag<I64>(ent_dim, name, ncomps, array, true);
+    } else if (is<Real>(tag.get())) {
+      auto array = as<Real>(tag.get())->array();
+      new_mesh->add_tag<Real>(ent_dim, name, ncomps, array, true);
     }
   }
   end_code();
@@ -1,8 +1,12 @@
 #ifndef OMEGA_H_MIGRATE_HPP
 #define OMEGA_H_MIGRATE_HPP
 
+#include <memory>
+#include <vector>
+
 #include <Omega_h_adj.hpp>
 #include <Omega_h_dist.hpp>
+#include <Omega_h_tag.hpp>
 
 namespace Omega_h {
 
@@ -42,6 +46,15 @@ void push_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
     Dist old_owners2new_ents, Adj& new_ents2new_lows,
     Dist& old_low_owners2new_lows);
 
+/* sends the arrays of several tags on the same entities
+   through (dist) at once: each entity's values for all tags
+   are packed into one row of bytes, so there is one message
+   per neighbor no matter how many tags or types there are.
+   returns unattached tags holding the received arrays,
+   in the same order as (tags) */
+std::vector<std::shared_ptr<TagBase>> exch_tags(
+    Dist const& dist, std::vector<TagBase const*> const& tags);
+
 void push_tags(Mesh const* old_mesh, Mesh* new_mesh, Int ent_dim,
     Dist old_owners2new_ents);
 
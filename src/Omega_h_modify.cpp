@@ -22,7 +22,8 @@ namespace Omega_h {
 
 static void modify_conn(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
     LOs prod_verts2verts, LOs prods2new_ents, LOs same_ents2old_ents,
-    LOs same_ents2new_ents, LOs old_lows2new_lows, LOs keys2kds) {
+    LOs same_ents2new_ents, LOs old_ents2new_ents, LOs old_lows2new_lows,
+    LOs keys2kds) {
   begin_code("modify_conn");
   (void)keys2kds;
   auto low_dim = ent_dim - 1;
@@ -66,6 +67,16 @@ static void modify_conn(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
   auto new_ents2new_lows =
       Adj(LOs(new_ent_lows2new_lows), Read<I8>(new_ent_low_codes));
   new_mesh->set_ents(ent_dim, new_ents2new_lows);
+  /* a rebuild usually changes a small part of the mesh, so if the
+     old mesh had this upward adjacency we patch it around the cavities
+     instead of inverting the whole new downward adjacency again */
+  if (old_mesh->has_adj(low_dim, ent_dim)) {
+    auto new_lows2new_ents = update_up_adj(
+        old_mesh->ask_up(low_dim, ent_dim), old_lows2new_lows,
+        old_ents2new_ents, new_mesh->nents(low_dim), prods2new_lows,
+        prods2new_ents, down_degree);
+    new_mesh->set_up(low_dim, ent_dim, new_lows2new_ents);
+  }
   end_code();
 }
 
@@ -386,7 +397,7 @@ void modify_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim, Int key_dim,
   } else {
     modify_conn(old_mesh, new_mesh, ent_dim, prod_verts2verts,
         *p_prods2new_ents, *p_same_ents2old_ents, *p_same_ents2new_ents,
-        old_lows2new_lows, keys2kds);
+        *p_old_ents2new_ents, old_lows2new_lows, keys2kds);
   }
   if (old_mesh->comm()->size() > 1) {
     modify_owners(old_mesh, new_mesh, ent_dim, *p_prods2new_ents,
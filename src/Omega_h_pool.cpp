@@ -0,0 +1,116 @@
+#include "Omega_h_pool.hpp"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Omega_h {
+
+enum { MIN_CLASS = 6, NCLASSES = 64 };
+
+struct Pool {
+  std::mutex mutex;
+  std::vector<void*> free_lists[NCLASSES];
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t cached_bytes = 0;
+  bool enabled = false;
+};
+
+/* constructed on first use and never destroyed, so that
+   arrays released during static destruction are still safe */
+static Pool& get_pool() {
+  static Pool* pool = new Pool();
+  return *pool;
+}
+
+static int get_size_class(std::size_t bytes) {
+  int c = MIN_CLASS;
+  while ((std::size_t(1) << c) < bytes) ++c;
+  return c;
+}
+
+void* pool_allocate(std::size_t* bytes) {
+  auto& pool = get_pool();
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (pool.enabled) {
+      auto c = get_size_class(*bytes);
+      *bytes = std::size_t(1) << c;
+      auto& list = pool.free_lists[c];
+      if (!list.empty()) {
+        auto ptr = list.back();
+        list.pop_back();
+        pool.cached_bytes -= *bytes;
+        ++pool.hits;
+        return ptr;
+      }
+      ++pool.misses;
+    }
+  }
+  return ::operator new(*bytes);
+}
+
+void pool_deallocate(void* ptr, std::size_t bytes) {
+  auto& pool = get_pool();
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    /* only blocks whose capacity is exactly a size class can be
+       reused. this includes some blocks allocated while pooling
+       was disabled, which is fine. */
+    auto c = get_size_class(bytes);
+    if (pool.enabled && (std::size_t(1) << c) == bytes) {
+      pool.free_lists[c].push_back(ptr);
+      pool.cached_bytes += bytes;
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
+static void free_cached_blocks(Pool& pool) {
+  for (auto& list : pool.free_lists) {
+    for (auto ptr : list) ::operator delete(ptr);
+    list.clear();
+  }
+  pool.cached_bytes = 0;
+}
+
+void enable_pooling() {
+  auto& pool = get_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  pool.enabled = true;
+}
+
+void disable_pooling() {
+  auto& pool = get_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  pool.enabled = false;
+  free_cached_blocks(pool);
+}
+
+bool is_pooling_enabled() {
+  auto& pool = get_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  return pool.enabled;
+}
+
+std::size_t get_pool_hits() {
+  auto& pool = get_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  return pool.hits;
+}
+
+std::size_t get_pool_misses() {
+  auto& pool = get_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  return pool.misses;
+}
+
+std::size_t get_pool_cached_bytes() {
+  auto& pool = get_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  return pool.cached_bytes;
+}
+
+}  // end namespace Omega_h
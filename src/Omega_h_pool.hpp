@@ -0,0 +1,34 @@
+#ifndef OMEGA_H_POOL_HPP
+#define OMEGA_H_POOL_HPP
+
+#include <cstddef>
+
+namespace Omega_h {
+
+/* a caching allocator for the memory behind Write<T>.
+   requests are rounded up to a power-of-two size class,
+   and freed blocks are kept in per-class free lists instead of
+   being returned to the system, so the many short-lived
+   temporaries of one adapt pass reuse the same memory.
+   pooling is off by default, see Library's --osh-pool flag.
+   with Kokkos, arrays are allocated by Kokkos and do not use this. */
+
+/* (*bytes) is increased to the capacity of the returned block,
+   and that capacity must be given back to pool_deallocate */
+void* pool_allocate(std::size_t* bytes);
+void pool_deallocate(void* ptr, std::size_t bytes);
+
+void enable_pooling();
+/* also returns all cached blocks to the system */
+void disable_pooling();
+bool is_pooling_enabled();
+
+/* hits are requests served from a free list,
+   misses are requests that had to allocate new memory */
+std::size_t get_pool_hits();
+std::size_t get_pool_misses();
+std::size_t get_pool_cached_bytes();
+
+}  // end namespace Omega_h
+
+#endif
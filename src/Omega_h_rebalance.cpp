@@ -0,0 +1,177 @@
+#include "Omega_h_rebalance.hpp"
+
+#include <vector>
+
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_element.hpp"
+#include "Omega_h_loop.hpp"
+#include "Omega_h_mark.hpp"
+#include "Omega_h_mesh.hpp"
+#include "Omega_h_metric.hpp"
+#include "Omega_h_migrate.hpp"
+
+namespace Omega_h {
+
+Reals get_balance_masses(Mesh* mesh, bool predictive) {
+  if (!predictive) return Reals(mesh->nelems(), 1);
+  auto masses = get_expected_nelems_per_elem(
+      mesh, mesh->get_array<Real>(VERT, "metric"));
+  /* average between input mesh weight (1.0)
+     and predicted output mesh weight */
+  masses = add_to_each(masses, 1.);
+  return multiply_each_by(masses, 1. / 2.);
+}
+
+/* for each side, the rank on the other side of it,
+   or this rank if the side is not on a part boundary */
+static Read<I32> get_sides2other_ranks(Mesh* mesh) {
+  auto side_dim = mesh->dim() - 1;
+  auto ranks = Read<I32>(mesh->nents(side_dim), mesh->comm()->rank());
+  auto min_ranks = mesh->reduce_array(side_dim, ranks, 1, OMEGA_H_MIN);
+  min_ranks = mesh->sync_array(side_dim, min_ranks, 1);
+  auto max_ranks = mesh->reduce_array(side_dim, ranks, 1, OMEGA_H_MAX);
+  max_ranks = mesh->sync_array(side_dim, max_ranks, 1);
+  auto rank = mesh->comm()->rank();
+  Write<I32> others(ranks.size());
+  auto f = OMEGA_H_LAMBDA(LO s) {
+    others[s] = (min_ranks[s] == rank) ? max_ranks[s] : min_ranks[s];
+  };
+  parallel_for(others.size(), f, "get_sides2other_ranks");
+  return others;
+}
+
+/* for each element, a neighbor rank it could be sent to,
+   or -1 if it is not on a part boundary */
+static Read<I32> get_elems2neighbor_ranks(Mesh* mesh) {
+  auto sides2others = get_sides2other_ranks(mesh);
+  auto elems2sides = mesh->ask_down(mesh->dim(), mesh->dim() - 1).ab2b;
+  auto nsides_per_elem =
+      element_degree(mesh->family(), mesh->dim(), mesh->dim() - 1);
+  auto rank = mesh->comm()->rank();
+  Write<I32> out(mesh->nelems());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    out[e] = -1;
+    for (Int es = 0; es < nsides_per_elem; ++es) {
+      auto other = sides2others[elems2sides[e * nsides_per_elem + es]];
+      if (other != rank) {
+        out[e] = other;
+        break;
+      }
+    }
+  };
+  parallel_for(mesh->nelems(), f, "get_elems2neighbor_ranks");
+  return out;
+}
+
+static I64 get_tag_bytes(TagBase const* tag) {
+  switch (tag->type()) {
+    case OMEGA_H_I8:
+      return tag->ncomps() * I64(sizeof(I8));
+    case OMEGA_H_I32:
+      return tag->ncomps() * I64(sizeof(I32));
+    case OMEGA_H_I64:
+      return tag->ncomps() * I64(sizeof(I64));
+    case OMEGA_H_F64:
+      return tag->ncomps() * I64(sizeof(Real));
+  }
+  return 0;
+}
+
+/* the bytes sent by this rank to move the marked elements:
+   the tags and downward connectivity of their closure */
+static I64 count_migrated_bytes(Mesh* mesh, Read<I8> elems_moving) {
+  I64 bytes = 0;
+  for (Int d = 0; d <= mesh->dim(); ++d) {
+    auto marks = mark_local_closure(mesh, d, elems_moving);
+    auto nmoving = I64(get_sum(marks));
+    I64 bytes_per_ent = 0;
+    for (Int i = 0; i < mesh->ntags(d); ++i) {
+      bytes_per_ent += get_tag_bytes(mesh->get_tag(d, i));
+    }
+    if (d > 0) {
+      bytes_per_ent +=
+          element_degree(mesh->family(), d, d - 1) * I64(sizeof(LO));
+    }
+    bytes += nmoving * bytes_per_ent;
+  }
+  return bytes;
+}
+
+/* the mass each neighbor rank should receive from this one, following
+   first-order diffusion with the safe coefficient of Cybenko:
+   1 / (1 + the larger of the two neighbor counts) */
+static std::vector<Real> get_flows(CommPtr comm, Real load,
+    Read<I32> elems2neighbors) {
+  auto nranks = comm->size();
+  auto h_elems2neighbors = HostRead<I32>(elems2neighbors);
+  std::vector<I8> is_neighbor(std::size_t(nranks), 0);
+  for (LO e = 0; e < h_elems2neighbors.size(); ++e) {
+    auto neighbor = h_elems2neighbors[e];
+    if (neighbor >= 0) is_neighbor[std::size_t(neighbor)] = 1;
+  }
+  I32 nneighbors = 0;
+  for (auto n : is_neighbor) nneighbors += n;
+  /* every rank learns every load and neighbor count,
+     in one reduction of (2 * nranks) values */
+  HostWrite<Real> h_posted(Write<Real>(2 * nranks, 0.0));
+  h_posted[comm->rank()] = load;
+  h_posted[nranks + comm->rank()] = Real(nneighbors);
+  auto posted = Read<Real>(h_posted.write());
+  auto gathered = HostRead<Real>(comm->allreduce(posted, OMEGA_H_SUM));
+  std::vector<Real> flows(std::size_t(nranks), 0.0);
+  for (I32 q = 0; q < nranks; ++q) {
+    if (!is_neighbor[std::size_t(q)]) continue;
+    auto excess = load - gathered[q];
+    if (excess <= 0.0) continue;
+    auto degree = max2(Real(nneighbors), gathered[nranks + q]);
+    flows[std::size_t(q)] = excess / (degree + 1.0);
+  }
+  return flows;
+}
+
+I64 rebalance_diffusively(
+    Mesh* mesh, Real max_imbalance, bool predictive, Int max_steps) {
+  auto comm = mesh->comm();
+  if (comm->size() == 1) return 0;
+  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  I64 bytes = 0;
+  for (Int step = 0; step < max_steps; ++step) {
+    auto masses = get_balance_masses(mesh, predictive);
+    auto load = get_sum(masses);
+    auto total = comm->allreduce(load, OMEGA_H_SUM);
+    auto heaviest = comm->allreduce(load, OMEGA_H_MAX);
+    if (heaviest <= max_imbalance * total / comm->size()) break;
+    auto elems2neighbors = get_elems2neighbor_ranks(mesh);
+    auto flows = get_flows(comm, load, elems2neighbors);
+    /* greedily fill each flow with boundary elements */
+    std::vector<Real> sent(flows.size(), 0.0);
+    auto h_elems2neighbors = HostRead<I32>(elems2neighbors);
+    auto h_masses = HostRead<Real>(masses);
+    HostWrite<I32> h_dest_ranks(mesh->nelems());
+    HostWrite<I8> h_moving(mesh->nelems());
+    for (LO e = 0; e < mesh->nelems(); ++e) {
+      h_dest_ranks[e] = comm->rank();
+      h_moving[e] = 0;
+      auto q = h_elems2neighbors[e];
+      if (q < 0) continue;
+      auto& sent_q = sent[std::size_t(q)];
+      if (sent_q + h_masses[e] / 2.0 >= flows[std::size_t(q)]) continue;
+      sent_q += h_masses[e];
+      h_dest_ranks[e] = q;
+      h_moving[e] = 1;
+    }
+    auto moving = Read<I8>(h_moving.write());
+    auto nmoving = comm->allreduce(I64(get_sum(moving)), OMEGA_H_SUM);
+    if (nmoving == 0) break;
+    bytes += count_migrated_bytes(mesh, moving);
+    Dist elems2new;
+    elems2new.set_parent_comm(comm);
+    elems2new.set_dest_ranks(Read<I32>(h_dest_ranks.write()));
+    elems2new.set_roots2items(LOs(mesh->nelems() + 1, 0, 1));
+    elems2new.set_dest_globals(mesh->globals(mesh->dim()));
+    migrate_mesh(mesh, elems2new.invert(), OMEGA_H_ELEM_BASED, false);
+  }
+  return comm->allreduce(bytes, OMEGA_H_SUM);
+}
+
+}  // end namespace Omega_h
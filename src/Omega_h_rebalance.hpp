@@ -0,0 +1,29 @@
+#ifndef OMEGA_H_REBALANCE_HPP
+#define OMEGA_H_REBALANCE_HPP
+
+#include <Omega_h_array.hpp>
+
+namespace Omega_h {
+
+class Mesh;
+
+/* the element weights used to balance a mesh: one per element,
+   or with (predictive) the average of that and the number of
+   elements the metric asks for */
+Reals get_balance_masses(Mesh* mesh, bool predictive);
+
+/* improves the balance of an element-partitioned mesh by
+   repeatedly sending a layer of elements along the part boundaries
+   from heavier ranks to lighter neighbor ranks, until the heaviest
+   rank holds at most (max_imbalance) times the average mass or
+   (max_steps) layers have been sent.
+   unlike Mesh::balance(), elements away from the part boundaries
+   never move, so a mesh that is already nearly balanced costs
+   little to fix.
+   returns the number of bytes of entity data migrated over all ranks */
+I64 rebalance_diffusively(Mesh* mesh, Real max_imbalance,
+    bool predictive = false, Int max_steps = 20);
+
+}  // end namespace Omega_h
+
+#endif
@@ -7,6 +7,7 @@
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_modify.hpp"
+#include "Omega_h_refine_batch.hpp"
 #include "Omega_h_refine_qualities.hpp"
 #include "Omega_h_refine_topology.hpp"
 #include "Omega_h_transfer.hpp"
@@ -93,6 +94,10 @@ bool refine_by_size(Mesh* mesh, AdaptOpts const& opts) {
   auto lengths = mesh->ask_lengths();
   auto edge_is_cand = each_gt(lengths, opts.max_length_desired);
   if (get_max(comm, edge_is_cand) != 1) return false;
+  if (opts.should_refine_in_batch && can_refine_in_batch(mesh, opts)) {
+    mesh->set_parting(OMEGA_H_ELEM_BASED);
+    if (refine_in_batch(mesh, opts, edge_is_cand)) return true;
+  }
   mesh->add_tag(EDGE, "candidate", 1, edge_is_cand);
   return refine(mesh, opts);
 }
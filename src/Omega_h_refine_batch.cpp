@@ -0,0 +1,596 @@
+#include "Omega_h_refine_batch.hpp"
+
+#include <iostream>
+
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_loop.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
+#include "Omega_h_mesh.hpp"
+#include "Omega_h_metric.hpp"
+#include "Omega_h_modify.hpp"
+#include "Omega_h_quality.hpp"
+#include "Omega_h_scan.hpp"
+#include "Omega_h_simplex.hpp"
+#include "Omega_h_transfer.hpp"
+
+namespace Omega_h {
+
+/* Batched refinement splits every key edge in a single rebuild,
+   rather than an independent set of them per rebuild.
+   Each entity with key edges is subdivided by recursive bisection:
+   a piece is bisected at the midpoint of the first of its key edges
+   in an order shared by the whole mesh (longest first, ties broken
+   by global number), until no piece contains a key edge.
+   Since that order is shared, two entities subdivide their common
+   boundary the same way and the new mesh is conforming.
+
+   In terms of modify_ents(), the split entities of each dimension
+   are the keys for that dimension.
+   The products of a key are its own children plus the new entities
+   of that dimension inside split entities of higher dimension,
+   which are given to the first split entity in their boundary.
+
+   Within an entity of dimension (dim), local vertices [0, dim] are
+   its own vertices and (dim + 1 + e) is the midpoint of its edge e. */
+
+template <Int dim>
+struct SplitCounts;
+template <>
+struct SplitCounts<1> {
+  enum { nedges = 1, max_children = 2, max_prods = 2 };
+};
+template <>
+struct SplitCounts<2> {
+  enum { nedges = 3, max_children = 4, max_prods = 12 };
+};
+template <>
+struct SplitCounts<3> {
+  enum { nedges = 6, max_children = 8, max_prods = 48 };
+};
+
+struct EdgeOrder {
+  Reals lengths;
+  Read<GO> globals;
+  OMEGA_H_DEVICE bool before(LO a, LO b) const {
+    if (lengths[a] != lengths[b]) return lengths[a] > lengths[b];
+    return globals[a] < globals[b];
+  }
+};
+
+/* the local key edges of a split entity, in the order they are used */
+template <Int dim>
+struct SplitOrder {
+  Few<Int, SplitCounts<dim>::nedges> edges;
+  Int nedges;
+};
+
+template <Int dim>
+struct GetSplitOrder {
+  static OMEGA_H_DEVICE SplitOrder<dim> get(LOs const& ents2edges, LO ent,
+      Read<I8> const& edges_are_keys, EdgeOrder const& order) {
+    enum { nedges = SplitCounts<dim>::nedges };
+    SplitOrder<dim> so;
+    so.nedges = 0;
+    for (Int e = 0; e < nedges; ++e) {
+      auto edge = ents2edges[ent * nedges + e];
+      if (!edges_are_keys[edge]) continue;
+      auto i = so.nedges++;
+      while (i > 0 &&
+             order.before(edge, ents2edges[ent * nedges + so.edges[i - 1]])) {
+        so.edges[i] = so.edges[i - 1];
+        --i;
+      }
+      so.edges[i] = e;
+    }
+    return so;
+  }
+};
+
+template <>
+struct GetSplitOrder<1> {
+  static OMEGA_H_DEVICE SplitOrder<1> get(LOs const&, LO,
+      Read<I8> const&, EdgeOrder const&) {
+    SplitOrder<1> so;
+    so.edges[0] = 0;
+    so.nedges = 1;
+    return so;
+  }
+};
+
+template <Int dim>
+struct Subdivision {
+  Few<Few<Int, dim + 1>, SplitCounts<dim>::max_children> children;
+  Int nchildren;
+};
+
+template <Int dim>
+OMEGA_H_DEVICE Subdivision<dim> subdivide(SplitOrder<dim> const& so) {
+  Subdivision<dim> sub;
+  sub.nchildren = 0;
+  /* every piece on the stack ends up as at least one child,
+     so the stack never holds more than max_children pieces */
+  Few<Few<Int, dim + 1>, SplitCounts<dim>::max_children> stack;
+  for (Int i = 0; i <= dim; ++i) stack[0][i] = i;
+  Int nstack = 1;
+  while (nstack) {
+    auto piece = stack[--nstack];
+    Int which = -1;
+    Int i0 = -1;
+    Int i1 = -1;
+    for (Int o = 0; o < so.nedges && which == -1; ++o) {
+      auto e = so.edges[o];
+      auto v0 = simplex_down_template(dim, EDGE, e, 0);
+      auto v1 = simplex_down_template(dim, EDGE, e, 1);
+      Int j0 = -1;
+      Int j1 = -1;
+      for (Int i = 0; i <= dim; ++i) {
+        if (piece[i] == v0) j0 = i;
+        if (piece[i] == v1) j1 = i;
+      }
+      if (j0 >= 0 && j1 >= 0) {
+        which = e;
+        i0 = j0;
+        i1 = j1;
+      }
+    }
+    if (which == -1) {
+      sub.children[sub.nchildren++] = piece;
+      continue;
+    }
+    /* replacing either endpoint of the bisected edge by its midpoint
+       preserves the orientation of the piece */
+    auto mid = dim + 1 + which;
+    auto other = piece;
+    other[i0] = mid;
+    stack[nstack++] = other;
+    piece[i1] = mid;
+    stack[nstack++] = piece;
+  }
+  return sub;
+}
+
+template <Int dim>
+OMEGA_H_DEVICE bool touches(Int local_vert, Int v) {
+  if (local_vert <= dim) return local_vert == v;
+  auto e = local_vert - (dim + 1);
+  return simplex_down_template(dim, EDGE, e, 0) == v ||
+         simplex_down_template(dim, EDGE, e, 1) == v;
+}
+
+template <Int dim, Int prod_dim>
+struct SplitProds {
+  Few<Few<Int, prod_dim + 1>, SplitCounts<dim>::max_prods> prods;
+  Int nprods;
+};
+
+/* the products of dimension (prod_dim) of a split entity:
+   its children if (prod_dim == dim), otherwise the entities of
+   its subdivision which are not on its boundary */
+template <Int dim, Int prod_dim>
+struct GetSplitProds {
+  static OMEGA_H_DEVICE SplitProds<dim, prod_dim> get(
+      SplitOrder<dim> const& so) {
+    auto sub = subdivide(so);
+    SplitProds<dim, prod_dim> sp;
+    sp.nprods = 0;
+    auto nsubs = simplex_degree(dim, prod_dim);
+    for (Int c = 0; c < sub.nchildren; ++c) {
+      for (Int s = 0; s < nsubs; ++s) {
+        Few<Int, prod_dim + 1> pv;
+        for (Int j = 0; j <= prod_dim; ++j) {
+          pv[j] = sub.children[c][simplex_down_template(dim, prod_dim, s, j)];
+        }
+        /* entities on the boundary miss some vertex of the parent */
+        bool is_interior = true;
+        for (Int v = 0; v <= dim; ++v) {
+          bool touched = false;
+          for (Int j = 0; j <= prod_dim; ++j) {
+            touched = touched || touches<dim>(pv[j], v);
+          }
+          is_interior = is_interior && touched;
+        }
+        if (!is_interior) continue;
+        for (Int j = 1; j <= prod_dim; ++j) {
+          for (Int k = j; k > 0 && pv[k] < pv[k - 1]; --k) {
+            swap2(pv[k], pv[k - 1]);
+          }
+        }
+        bool is_new = true;
+        for (Int p = 0; p < sp.nprods && is_new; ++p) {
+          bool same = true;
+          for (Int j = 0; j <= prod_dim; ++j) {
+            same = same && (sp.prods[p][j] == pv[j]);
+          }
+          is_new = !same;
+        }
+        if (is_new) sp.prods[sp.nprods++] = pv;
+      }
+    }
+    return sp;
+  }
+};
+
+template <Int dim>
+struct GetSplitProds<dim, dim> {
+  static OMEGA_H_DEVICE SplitProds<dim, dim> get(SplitOrder<dim> const& so) {
+    auto sub = subdivide(so);
+    SplitProds<dim, dim> sp;
+    sp.nprods = sub.nchildren;
+    for (Int c = 0; c < sub.nchildren; ++c) sp.prods[c] = sub.children[c];
+    return sp;
+  }
+};
+
+template <>
+struct GetSplitProds<1, 1> {
+  static OMEGA_H_DEVICE SplitProds<1, 1> get(SplitOrder<1> const&) {
+    SplitProds<1, 1> sp;
+    sp.nprods = 2;
+    sp.prods[0][0] = 0;
+    sp.prods[0][1] = 2;
+    sp.prods[1][0] = 2;
+    sp.prods[1][1] = 1;
+    return sp;
+  }
+};
+
+/* maps the local vertices of a split entity to new mesh vertices */
+template <Int dim>
+struct SplitVerts {
+  LOs ents2verts;
+  LOs ents2edges;
+  LOs old_verts2new_verts;
+  LOs edges2keys;
+  LOs keys2midverts;
+  OMEGA_H_DEVICE LO get(LO ent, Int local_vert) const {
+    if (local_vert <= dim) {
+      return old_verts2new_verts[ents2verts[ent * (dim + 1) + local_vert]];
+    }
+    auto e = local_vert - (dim + 1);
+    auto edge =
+        (dim == 1) ? ent : ents2edges[ent * SplitCounts<dim>::nedges + e];
+    return keys2midverts[edges2keys[edge]];
+  }
+};
+
+struct BatchSplits {
+  Read<I8> edges_are_keys;
+  LOs edges2keys;
+  EdgeOrder order;
+  LOs keys2midverts;
+  LOs old_verts2new_verts;
+  LOs splits2ents[4];
+};
+
+static LOs get_ents2edges(Mesh* mesh, Int dim) {
+  if (dim == EDGE) return LOs();
+  return mesh->ask_down(dim, EDGE).ab2b;
+}
+
+template <Int dim, Int prod_dim>
+static LOs count_split_prods_tmpl(Mesh* mesh, BatchSplits const& bs) {
+  auto ents2edges = get_ents2edges(mesh, dim);
+  auto splits2ents = bs.splits2ents[dim];
+  auto edges_are_keys = bs.edges_are_keys;
+  auto order = bs.order;
+  auto nsplits = splits2ents.size();
+  Write<LO> counts(nsplits);
+  auto f = OMEGA_H_LAMBDA(LO split) {
+    auto ent = splits2ents[split];
+    auto so = GetSplitOrder<dim>::get(ents2edges, ent, edges_are_keys, order);
+    counts[split] = GetSplitProds<dim, prod_dim>::get(so).nprods;
+  };
+  parallel_for(nsplits, f, "count_split_prods");
+  return counts;
+}
+
+template <Int dim, Int prod_dim>
+static void fill_split_prods_tmpl(Mesh* mesh, BatchSplits const& bs,
+    LOs splits2first_prods, Write<LO> prod_verts2verts,
+    Write<I8> prods2parent_dims, Write<LO> prods2parents) {
+  auto ents2edges = get_ents2edges(mesh, dim);
+  auto splits2ents = bs.splits2ents[dim];
+  auto edges_are_keys = bs.edges_are_keys;
+  auto order = bs.order;
+  SplitVerts<dim> verts;
+  verts.ents2verts = mesh->ask_verts_of(dim);
+  verts.ents2edges = ents2edges;
+  verts.old_verts2new_verts = bs.old_verts2new_verts;
+  verts.edges2keys = bs.edges2keys;
+  verts.keys2midverts = bs.keys2midverts;
+  auto nsplits = splits2ents.size();
+  auto f = OMEGA_H_LAMBDA(LO split) {
+    auto ent = splits2ents[split];
+    auto so = GetSplitOrder<dim>::get(ents2edges, ent, edges_are_keys, order);
+    auto sp = GetSplitProds<dim, prod_dim>::get(so);
+    auto prod = splits2first_prods[split];
+    for (Int p = 0; p < sp.nprods; ++p, ++prod) {
+      for (Int j = 0; j <= prod_dim; ++j) {
+        prod_verts2verts[prod * (prod_dim + 1) + j] =
+            verts.get(ent, sp.prods[p][j]);
+      }
+      prods2parent_dims[prod] = I8(dim);
+      prods2parents[prod] = ent;
+    }
+  };
+  parallel_for(nsplits, f, "fill_split_prods");
+}
+
+static LOs count_split_prods(
+    Mesh* mesh, Int dim, Int prod_dim, BatchSplits const& bs) {
+  if (dim == 1 && prod_dim == 1) {
+    return count_split_prods_tmpl<1, 1>(mesh, bs);
+  }
+  if (dim == 2 && prod_dim == 1) {
+    return count_split_prods_tmpl<2, 1>(mesh, bs);
+  }
+  if (dim == 2 && prod_dim == 2) {
+    return count_split_prods_tmpl<2, 2>(mesh, bs);
+  }
+  if (dim == 3 && prod_dim == 1) {
+    return count_split_prods_tmpl<3, 1>(mesh, bs);
+  }
+  if (dim == 3 && prod_dim == 2) {
+    return count_split_prods_tmpl<3, 2>(mesh, bs);
+  }
+  if (dim == 3 && prod_dim == 3) {
+    return count_split_prods_tmpl<3, 3>(mesh, bs);
+  }
+  OMEGA_H_NORETURN(LOs());
+}
+
+static void fill_split_prods(Mesh* mesh, Int dim, Int prod_dim,
+    BatchSplits const& bs, LOs splits2first_prods, Write<LO> prod_verts2verts,
+    Write<I8> prods2parent_dims, Write<LO> prods2parents) {
+  if (dim == 1 && prod_dim == 1) {
+    fill_split_prods_tmpl<1, 1>(mesh, bs, splits2first_prods,
+        prod_verts2verts, prods2parent_dims, prods2parents);
+  } else if (dim == 2 && prod_dim == 1) {
+    fill_split_prods_tmpl<2, 1>(mesh, bs, splits2first_prods,
+        prod_verts2verts, prods2parent_dims, prods2parents);
+  } else if (dim == 2 && prod_dim == 2) {
+    fill_split_prods_tmpl<2, 2>(mesh, bs, splits2first_prods,
+        prod_verts2verts, prods2parent_dims, prods2parents);
+  } else if (dim == 3 && prod_dim == 1) {
+    fill_split_prods_tmpl<3, 1>(mesh, bs, splits2first_prods,
+        prod_verts2verts, prods2parent_dims, prods2parents);
+  } else if (dim == 3 && prod_dim == 2) {
+    fill_split_prods_tmpl<3, 2>(mesh, bs, splits2first_prods,
+        prod_verts2verts, prods2parent_dims, prods2parents);
+  } else if (dim == 3 && prod_dim == 3) {
+    fill_split_prods_tmpl<3, 3>(mesh, bs, splits2first_prods,
+        prod_verts2verts, prods2parent_dims, prods2parents);
+  } else {
+    Omega_h_fail("fill_split_prods: unsupported dimensions\n");
+  }
+}
+
+/* the key (split entity of dimension prod_dim) that each split entity
+   of dimension (dim) gives its products of dimension (prod_dim) to */
+static LOs get_splits2keys(
+    Mesh* mesh, Int dim, Int prod_dim, BatchSplits const& bs) {
+  auto nlows = mesh->nents(prod_dim);
+  auto low_splits2lows = bs.splits2ents[prod_dim];
+  auto lows2keys = map_onto(LOs(low_splits2lows.size(), 0, 1), low_splits2lows,
+      nlows, -1, 1);
+  auto splits2ents = bs.splits2ents[dim];
+  if (dim == prod_dim) return unmap(splits2ents, lows2keys, 1);
+  auto ents2lows = mesh->ask_down(dim, prod_dim).ab2b;
+  auto nlows_per_ent = simplex_degree(dim, prod_dim);
+  auto nsplits = splits2ents.size();
+  Write<LO> splits2keys(nsplits);
+  auto f = OMEGA_H_LAMBDA(LO split) {
+    auto ent = splits2ents[split];
+    LO key = -1;
+    for (Int i = 0; i < nlows_per_ent && key == -1; ++i) {
+      key = lows2keys[ents2lows[ent * nlows_per_ent + i]];
+    }
+    splits2keys[split] = key;
+  };
+  parallel_for(nsplits, f, "get_splits2keys");
+  return splits2keys;
+}
+
+static void get_batch_prods(Mesh* mesh, Int prod_dim, BatchSplits const& bs,
+    LOs* p_keys2prods, LOs* p_prod_verts2verts, Read<I8>* p_prods2parent_dims,
+    LOs* p_prods2parents) {
+  auto nkeys = bs.splits2ents[prod_dim].size();
+  auto mesh_dim = mesh->dim();
+  Graph keys2splits[4];
+  LOs splits2counts[4];
+  auto keys2nprods = LOs(nkeys, 0);
+  for (Int dim = prod_dim; dim <= mesh_dim; ++dim) {
+    splits2counts[dim] = count_split_prods(mesh, dim, prod_dim, bs);
+    auto splits2keys = get_splits2keys(mesh, dim, prod_dim, bs);
+    keys2splits[dim] = invert_map_by_sorting(splits2keys, nkeys);
+    auto key_splits2counts =
+        unmap(keys2splits[dim].ab2b, splits2counts[dim], 1);
+    auto keys2dim_nprods = fan_reduce(
+        keys2splits[dim].a2ab, key_splits2counts, 1, OMEGA_H_SUM);
+    keys2nprods = add_each(keys2nprods, keys2dim_nprods);
+  }
+  auto keys2prods = offset_scan(keys2nprods);
+  auto nprods = keys2prods.last();
+  Write<LO> prod_verts2verts(nprods * (prod_dim + 1));
+  Write<I8> prods2parent_dims(nprods);
+  Write<LO> prods2parents(nprods);
+  auto keys2next_prod = deep_copy(keys2prods);
+  for (Int dim = prod_dim; dim <= mesh_dim; ++dim) {
+    auto keys2key_splits = keys2splits[dim].a2ab;
+    auto key_splits2splits = keys2splits[dim].ab2b;
+    auto counts = splits2counts[dim];
+    Write<LO> splits2first_prods(counts.size());
+    auto f = OMEGA_H_LAMBDA(LO key) {
+      auto prod = keys2next_prod[key];
+      for (auto ks = keys2key_splits[key]; ks < keys2key_splits[key + 1];
+           ++ks) {
+        auto split = key_splits2splits[ks];
+        splits2first_prods[split] = prod;
+        prod += counts[split];
+      }
+      keys2next_prod[key] = prod;
+    };
+    parallel_for(nkeys, f, "get_batch_prods");
+    fill_split_prods(mesh, dim, prod_dim, bs, splits2first_prods,
+        prod_verts2verts, prods2parent_dims, prods2parents);
+  }
+  *p_keys2prods = keys2prods;
+  *p_prod_verts2verts = prod_verts2verts;
+  *p_prods2parent_dims = prods2parent_dims;
+  *p_prods2parents = prods2parents;
+}
+
+template <Int mesh_dim, Int metric_dim>
+static Read<I8> mark_bad_splits_tmpl(Mesh* mesh, Read<I8> edges_are_keys,
+    EdgeOrder const& order, Real min_qual) {
+  auto elems2edges = mesh->ask_down(mesh_dim, EDGE).ab2b;
+  auto elems2verts = mesh->ask_elem_verts();
+  auto coords = mesh->coords();
+  auto metrics = mesh->get_array<Real>(VERT, "metric");
+  auto keys2edges = collect_marked(edges_are_keys);
+  auto edges2keys = map_onto(LOs(keys2edges.size(), 0, 1), keys2edges,
+      mesh->nedges(), -1, 1);
+  auto midpt_metrics = get_mident_metrics(mesh, EDGE, keys2edges, metrics);
+  auto nelems = mesh->nelems();
+  Write<I8> elems_are_bad(nelems);
+  auto f = OMEGA_H_LAMBDA(LO elem) {
+    auto so = GetSplitOrder<mesh_dim>::get(
+        elems2edges, elem, edges_are_keys, order);
+    elems_are_bad[elem] = 0;
+    if (!so.nedges) return;
+    auto sub = subdivide(so);
+    for (Int c = 0; c < sub.nchildren; ++c) {
+      Few<Vector<mesh_dim>, mesh_dim + 1> p;
+      Few<Matrix<metric_dim, metric_dim>, mesh_dim + 1> ms;
+      for (Int i = 0; i <= mesh_dim; ++i) {
+        auto lv = sub.children[c][i];
+        if (lv <= mesh_dim) {
+          auto v = elems2verts[elem * (mesh_dim + 1) + lv];
+          p[i] = get_vector<mesh_dim>(coords, v);
+          ms[i] = get_symm<metric_dim>(metrics, v);
+        } else {
+          auto e = lv - (mesh_dim + 1);
+          auto v0 = elems2verts[elem * (mesh_dim + 1) +
+                                simplex_down_template(mesh_dim, EDGE, e, 0)];
+          auto v1 = elems2verts[elem * (mesh_dim + 1) +
+                                simplex_down_template(mesh_dim, EDGE, e, 1)];
+          p[i] = (get_vector<mesh_dim>(coords, v0) +
+                     get_vector<mesh_dim>(coords, v1)) /
+                 2.;
+          auto edge = elems2edges[elem * SplitCounts<mesh_dim>::nedges + e];
+          auto key = edges2keys[edge];
+          ms[i] = get_symm<metric_dim>(midpt_metrics, key);
+        }
+      }
+      auto m = maxdet_metric(ms);
+      if (metric_element_quality(p, m) < min_qual) elems_are_bad[elem] = 1;
+    }
+  };
+  parallel_for(nelems, f, "mark_bad_splits");
+  return elems_are_bad;
+}
+
+/* marks elements whose subdivision would create children of
+   quality below (min_qual) */
+static Read<I8> mark_bad_splits(Mesh* mesh, Read<I8> edges_are_keys,
+    EdgeOrder const& order, Real min_qual) {
+  auto mesh_dim = mesh->dim();
+  auto metric_dim = get_metric_dim(mesh);
+  if (mesh_dim == 3 && metric_dim == 3) {
+    return mark_bad_splits_tmpl<3, 3>(mesh, edges_are_keys, order, min_qual);
+  }
+  if (mesh_dim == 2 && metric_dim == 2) {
+    return mark_bad_splits_tmpl<2, 2>(mesh, edges_are_keys, order, min_qual);
+  }
+  if (mesh_dim == 3 && metric_dim == 1) {
+    return mark_bad_splits_tmpl<3, 1>(mesh, edges_are_keys, order, min_qual);
+  }
+  if (mesh_dim == 2 && metric_dim == 1) {
+    return mark_bad_splits_tmpl<2, 1>(mesh, edges_are_keys, order, min_qual);
+  }
+  OMEGA_H_NORETURN(Read<I8>());
+}
+
+static void refine_batch_element_based(Mesh* mesh, AdaptOpts const& opts,
+    Read<I8> edges_are_keys, EdgeOrder const& order) {
+  auto comm = mesh->comm();
+  auto keys2edges = collect_marked(edges_are_keys);
+  auto nkeys = keys2edges.size();
+  auto ntotal_keys = comm->allreduce(GO(nkeys), OMEGA_H_SUM);
+  if (opts.verbosity >= EACH_REBUILD && comm->rank() == 0) {
+    std::cout << "refining " << ntotal_keys << " edges in one batch\n";
+  }
+  mesh->add_tag(
+      EDGE, "edge2rep_order", 1, get_edge2rep_order(mesh, edges_are_keys));
+  BatchSplits bs;
+  bs.edges_are_keys = edges_are_keys;
+  bs.edges2keys =
+      map_onto(LOs(nkeys, 0, 1), keys2edges, mesh->nedges(), -1, 1);
+  bs.order = order;
+  bs.splits2ents[EDGE] = keys2edges;
+  for (Int dim = EDGE + 1; dim <= mesh->dim(); ++dim) {
+    bs.splits2ents[dim] =
+        collect_marked(mark_up(mesh, EDGE, dim, edges_are_keys));
+  }
+  auto new_mesh = mesh->copy_meta();
+  auto prods2new_ents = LOs();
+  auto same_ents2old_ents = LOs();
+  auto same_ents2new_ents = LOs();
+  auto old_ents2new_ents = LOs();
+  auto keys2prods = LOs(nkeys + 1, 0, 1);
+  modify_ents(mesh, &new_mesh, VERT, EDGE, keys2edges, keys2prods, LOs(),
+      LOs(), &prods2new_ents, &same_ents2old_ents, &same_ents2new_ents,
+      &old_ents2new_ents);
+  bs.keys2midverts = prods2new_ents;
+  bs.old_verts2new_verts = old_ents2new_ents;
+  transfer_refine(mesh, opts.xfer_opts, &new_mesh, keys2edges,
+      bs.keys2midverts, VERT, keys2prods, prods2new_ents, same_ents2old_ents,
+      same_ents2new_ents);
+  auto old_lows2new_lows = old_ents2new_ents;
+  for (Int ent_dim = EDGE; ent_dim <= mesh->dim(); ++ent_dim) {
+    auto prod_verts2verts = LOs();
+    auto prods2parent_dims = Read<I8>();
+    auto prods2parents = LOs();
+    get_batch_prods(mesh, ent_dim, bs, &keys2prods, &prod_verts2verts,
+        &prods2parent_dims, &prods2parents);
+    modify_ents(mesh, &new_mesh, ent_dim, ent_dim, bs.splits2ents[ent_dim],
+        keys2prods, prod_verts2verts, old_lows2new_lows, &prods2new_ents,
+        &same_ents2old_ents, &same_ents2new_ents, &old_ents2new_ents);
+    transfer_refine_batch(mesh, opts.xfer_opts, &new_mesh, ent_dim,
+        prods2parent_dims, prods2parents, prods2new_ents, same_ents2old_ents,
+        same_ents2new_ents);
+    old_lows2new_lows = old_ents2new_ents;
+  }
+  *mesh = new_mesh;
+}
+
+bool can_refine_in_batch(Mesh* mesh, AdaptOpts const& opts) {
+  return mesh->comm()->size() == 1 && mesh->family() == OMEGA_H_SIMPLEX &&
+         (mesh->dim() == 2 || mesh->dim() == 3) &&
+         !should_conserve_any(mesh, opts.xfer_opts) &&
+         !has_momentum_velocity(mesh, opts.xfer_opts);
+}
+
+bool refine_in_batch(
+    Mesh* mesh, AdaptOpts const& opts, Read<I8> edges_are_cands) {
+  OMEGA_H_CHECK(can_refine_in_batch(mesh, opts));
+  EdgeOrder order;
+  order.lengths = mesh->ask_lengths();
+  order.globals = mesh->globals(EDGE);
+  auto edges_are_keys = edges_are_cands;
+  /* leave out every edge of an element that would get a bad child.
+     this can only remove keys, so it ends after a few passes */
+  while (true) {
+    auto elems_are_bad = mark_bad_splits(
+        mesh, edges_are_keys, order, opts.min_quality_allowed);
+    if (get_max(elems_are_bad) != 1) break;
+    auto edges_are_bad = mark_down(mesh, mesh->dim(), EDGE, elems_are_bad);
+    edges_are_keys = land_each(edges_are_keys, invert_marks(edges_are_bad));
+  }
+  if (get_max(edges_are_keys) != 1) return false;
+  refine_batch_element_based(mesh, opts, edges_are_keys, order);
+  return true;
+}
+
+}  // end namespace Omega_h
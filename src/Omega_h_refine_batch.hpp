@@ -0,0 +1,23 @@
+#ifndef OMEGA_H_REFINE_BATCH_HPP
+#define OMEGA_H_REFINE_BATCH_HPP
+
+#include <Omega_h_adapt.hpp>
+
+namespace Omega_h {
+
+class Mesh;
+
+/* whether refine_in_batch() can be used on this mesh with these options */
+bool can_refine_in_batch(Mesh* mesh, AdaptOpts const& opts);
+
+/* splits all candidate edges in a single rebuild by subdividing
+   each element according to its pattern of split edges.
+   candidates whose split would create elements below
+   opts.min_quality_allowed are left for later rebuilds.
+   returns false if no candidates could be split */
+bool refine_in_batch(
+    Mesh* mesh, AdaptOpts const& opts, Read<I8> edges_are_cands);
+
+}  // end namespace Omega_h
+
+#endif
@@ -7,8 +7,6 @@
 #include <Omega_h_thrust.hpp>
 #elif defined(OMEGA_H_USE_OPENMP)
 #include <omp.h>
-#include <pss/parallel_stable_sort.hpp>
-#include <pss/pss_common.hpp>
 #endif
 
 #include "Omega_h_array_ops.hpp"
@@ -19,18 +17,13 @@
 
 namespace Omega_h {
 
+#ifdef OMEGA_H_USE_CUDA
 template <typename T, typename Comp>
 static void parallel_sort(T* b, T* e, Comp c) {
   begin_code("parallel_sort");
-#if defined(OMEGA_H_USE_CUDA)
   auto bptr = thrust::device_ptr<T>(b);
   auto eptr = thrust::device_ptr<T>(e);
   thrust::stable_sort(bptr, eptr, c);
-#elif defined(OMEGA_H_USE_OPENMP)
-  pss::parallel_stable_sort(b, e, c);
-#else
-  std::stable_sort(b, e, c);
-#endif
   end_code();
 }
 
@@ -47,17 +40,149 @@ struct CompareKeySets {
     return false;
   }
 };
+#else
+/* On the host, sort_by_keys is an LSD radix sort of the permutation.
+   The key tuples are sorted one integer at a time starting from the last,
+   and each integer one byte at a time starting from the lowest.
+   Every pass is a stable counting sort, so the result is identical
+   to that of the stable comparison sort.
+   The current integer of every key is gathered once into a contiguous
+   array that moves along with the permutation, so the byte passes
+   do not chase the permutation into the key array.
+   Passes in which all keys have the same byte value
+   (typically the high bytes of LO keys) are skipped. */
+
+template <typename T>
+struct RadixTraits;
+
+template <>
+struct RadixTraits<I32> {
+  typedef std::uint32_t type;
+};
+
+template <>
+struct RadixTraits<I64> {
+  typedef std::uint64_t type;
+};
+
+/* maps signed integers to unsigned ones of the same order */
+template <typename T>
+static inline typename RadixTraits<T>::type to_radix(T x) {
+  typedef typename RadixTraits<T>::type U;
+  return static_cast<U>(x) ^ (U(1) << (sizeof(U) * 8 - 1));
+}
+
+enum { RADIX_BITS = 8, RADIX = 1 << RADIX_BITS };
+
+static int get_radix_nchunks(LO n) {
+#ifdef OMEGA_H_USE_OPENMP
+  auto nchunks = omp_get_max_threads();
+  /* not worth splitting less than a few histograms worth of items */
+  auto max_nchunks = n / (RADIX * 4);
+  if (nchunks > max_nchunks) nchunks = max_nchunks;
+  return (nchunks < 1) ? 1 : nchunks;
+#else
+  (void)n;
+  return 1;
+#endif
+}
+
+static void get_radix_chunk(LO n, int chunk, int nchunks, LO* b, LO* e) {
+  *b = LO((I64(n) * chunk) / nchunks);
+  *e = LO((I64(n) * (chunk + 1)) / nchunks);
+}
+
+template <typename U>
+static void radix_sort_digits(LO n, int nchunks, U** p_vals, LO** p_perm,
+    U** p_vals2, LO** p_perm2) {
+  std::vector<LO> counts(std::size_t(nchunks * RADIX));
+  for (int shift = 0; shift < int(sizeof(U) * 8); shift += RADIX_BITS) {
+    U const* vals = *p_vals;
+    LO const* perm = *p_perm;
+    U* vals2 = *p_vals2;
+    LO* perm2 = *p_perm2;
+    std::fill(counts.begin(), counts.end(), 0);
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for num_threads(nchunks)
+#endif
+    for (int c = 0; c < nchunks; ++c) {
+      LO b, e;
+      get_radix_chunk(n, c, nchunks, &b, &e);
+      LO* hist = counts.data() + c * RADIX;
+      for (LO i = b; i < e; ++i) ++hist[(vals[i] >> shift) & (RADIX - 1)];
+    }
+    auto first_digit = int((vals[0] >> shift) & (RADIX - 1));
+    LO nfirst = 0;
+    for (int c = 0; c < nchunks; ++c) {
+      nfirst += counts[std::size_t(c * RADIX + first_digit)];
+    }
+    if (nfirst == n) continue;
+    LO offset = 0;
+    for (int d = 0; d < RADIX; ++d) {
+      for (int c = 0; c < nchunks; ++c) {
+        auto& count = counts[std::size_t(c * RADIX + d)];
+        auto next_offset = offset + count;
+        count = offset;
+        offset = next_offset;
+      }
+    }
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for num_threads(nchunks)
+#endif
+    for (int c = 0; c < nchunks; ++c) {
+      LO b, e;
+      get_radix_chunk(n, c, nchunks, &b, &e);
+      LO* dests = counts.data() + c * RADIX;
+      for (LO i = b; i < e; ++i) {
+        auto dest = dests[(vals[i] >> shift) & (RADIX - 1)]++;
+        vals2[dest] = vals[i];
+        perm2[dest] = perm[i];
+      }
+    }
+    std::swap(*p_vals, *p_vals2);
+    std::swap(*p_perm, *p_perm2);
+  }
+}
+
+template <Int N, typename T>
+static LOs radix_sort_by_keys(Read<T> keys, LO n) {
+  typedef typename RadixTraits<T>::type U;
+  Write<LO> perm_a(n, 0, 1);
+  if (n < 2) return perm_a;
+  Write<LO> perm_b(n);
+  std::vector<U> vals_a(static_cast<std::size_t>(n));
+  std::vector<U> vals_b(static_cast<std::size_t>(n));
+  auto nchunks = get_radix_nchunks(n);
+  T const* keyptr = keys.data();
+  LO* perm = perm_a.data();
+  LO* perm2 = perm_b.data();
+  U* vals = vals_a.data();
+  U* vals2 = vals_b.data();
+  for (Int k = N - 1; k >= 0; --k) {
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (LO i = 0; i < n; ++i) vals[i] = to_radix(keyptr[perm[i] * N + k]);
+    radix_sort_digits(n, nchunks, &vals, &perm, &vals2, &perm2);
+  }
+  return (perm == perm_a.data()) ? perm_a : perm_b;
+}
+#endif
 
 template <Int N, typename T>
 static LOs sort_by_keys_tmpl(Read<T> keys) {
   begin_code("sort_by_keys");
   auto n = divide_no_remainder(keys.size(), N);
+#ifdef OMEGA_H_USE_CUDA
   Write<LO> perm(n, 0, 1);
   LO* begin = perm.data();
   LO* end = perm.data() + n;
   T const* keyptr = keys.data();
   parallel_sort<LO, CompareKeySets<T, N>>(
       begin, end, CompareKeySets<T, N>(keyptr));
+#else
+  auto perm = radix_sort_by_keys<N>(keys, n);
+#endif
   end_code();
   return perm;
 }
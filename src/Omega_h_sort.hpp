@@ -7,7 +7,7 @@ namespace Omega_h {
 
 /* Compute the permutation which sorts the given keys.
    Each key is a tuple of N integers of type T.
-   T may be 32 or 64 bits, and N may be 1, 2, or 3.
+   T may be 32 or 64 bits, and N may be 1, 2, 3, or 4.
    Let perm = sort_by_keys(keys, width);
    Then the key at perm[i] is <= the key at perm[i + 1].
    In other words, old_key_index = perm[new_key_index]
@@ -17,6 +17,8 @@ namespace Omega_h {
    Tuples (keys) are sorted into lexical order, so they
    will be sorted by the first integer first, second
    integer second, etc.
+   On the host this is an LSD radix sort, with CUDA
+   it is a comparison sort using Thrust.
  */
 template <typename T>
 LOs sort_by_keys(Read<T> keys, Int width = 1);
@@ -56,7 +56,7 @@ static void swap3d_element_based(Mesh* mesh, AdaptOpts const& opts) {
   transfer_copy(mesh, opts.xfer_opts, &new_mesh, VERT);
   auto keys2prods = swap3d_keys_to_prods(mesh, keys2edges);
   auto prod_verts2verts =
-      swap3d_topology(mesh, keys2edges, edges_configs, keys2prods);
+      swap3d_topology(mesh, opts, keys2edges, edges_configs, keys2prods);
   auto old_lows2new_lows = LOs(mesh->nverts(), 0, 1);
   for (Int ent_dim = EDGE; ent_dim <= mesh->dim(); ++ent_dim) {
     auto prods2new_ents = LOs();
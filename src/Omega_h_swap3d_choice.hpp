@@ -12,9 +12,132 @@ struct Choice {
   Real quality;
 };
 
+/* the minimum quality of the two tets formed by connecting
+   a triangle of loop vertices to the two edge vertices */
+template <typename QualityMeasure>
+OMEGA_H_DEVICE Real measure_loop_tri(Loop const& loop,
+    QualityMeasure const& quality_measure, Few<Int, 3> tri_verts2loop_verts) {
+  /* the first three tet vertices are
+     the same as the bottom triangle,
+     curling into the tet. */
+  Few<LO, 4> tet_verts2verts;
+  for (Int tri_vert = 0; tri_vert < 3; ++tri_vert) {
+    auto loop_vert = tri_verts2loop_verts[tri_vert];
+    tet_verts2verts[tri_vert] = loop.loop_verts2verts[loop_vert];
+  }
+  /* each triangle will support two tets,
+     one above and one below. this loop
+     forms those tets, swapping vertices
+     in between to maintain proper orientation. */
+  Real tri_minqual = 1.0;
+  for (Int tri_tet = 0; tri_tet < 2; ++tri_tet) {
+    tet_verts2verts[3] = loop.eev2v[1 - tri_tet];
+    auto tet_qual = quality_measure.measure(tet_verts2verts);
+    tri_minqual = min2(tri_minqual, tet_qual);
+    swap2(tet_verts2verts[1], tet_verts2verts[2]);
+  }
+  return tri_minqual;
+}
+
+struct LoopTriangulation {
+  Few<Few<Int, 3>, MAX_LOOP_SIZE - 2> tris;
+  Few<Few<Int, 2>, MAX_LOOP_SIZE - 3> edges;
+  Real quality;
+};
+
+/* the triangulation of the loop polygon that maximizes the minimum
+   quality of the resulting tets, without creating edges longer
+   than (max_length_allowed).
+   the best triangulation of the sub-polygon from loop vertex (i)
+   to loop vertex (j) consists of one triangle (i, k, j) and the
+   best triangulations of the sub-polygons (i, k) and (k, j),
+   which gives an O(n^3) dynamic program over all (i, j).
+   a (quality) of zero or less means no valid triangulation exists.
+   triangles come out with increasing loop vertices, which curl
+   the same way as the loop. */
+template <typename QualityMeasure, typename LengthMeasure>
+OMEGA_H_DEVICE LoopTriangulation triangulate_loop(Loop const& loop,
+    QualityMeasure const& quality_measure, LengthMeasure const& length_measure,
+    Real max_length_allowed) {
+  auto n = loop.size;
+  Real best[MAX_LOOP_SIZE][MAX_LOOP_SIZE];
+  Int split[MAX_LOOP_SIZE][MAX_LOOP_SIZE];
+  for (Int i = 0; i + 1 < n; ++i) best[i][i + 1] = 1.0;
+  for (Int span = 2; span < n; ++span) {
+    for (Int i = 0; i + span < n; ++i) {
+      auto j = i + span;
+      best[i][j] = -1.0;
+      split[i][j] = -1;
+      /* (0, n - 1) is a loop edge, all other (i, j) are new edges */
+      if (span < n - 1) {
+        Few<LO, 2> edge_verts2verts;
+        edge_verts2verts[0] = loop.loop_verts2verts[i];
+        edge_verts2verts[1] = loop.loop_verts2verts[j];
+        if (length_measure.measure(edge_verts2verts) > max_length_allowed) {
+          continue;
+        }
+      }
+      for (Int k = i + 1; k < j; ++k) {
+        auto qual = min2(best[i][k], best[k][j]);
+        if (qual <= best[i][j]) continue;
+        Few<Int, 3> tri_verts2loop_verts;
+        tri_verts2loop_verts[0] = i;
+        tri_verts2loop_verts[1] = k;
+        tri_verts2loop_verts[2] = j;
+        auto tri_qual =
+            measure_loop_tri(loop, quality_measure, tri_verts2loop_verts);
+        qual = min2(qual, tri_qual);
+        if (qual > best[i][j]) {
+          best[i][j] = qual;
+          split[i][j] = k;
+        }
+      }
+    }
+  }
+  LoopTriangulation tri;
+  tri.quality = best[0][n - 1];
+  if (tri.quality <= 0.0) return tri;
+  Few<Few<Int, 2>, MAX_LOOP_SIZE> stack;
+  Int nstack = 0;
+  Int ntris = 0;
+  Int nplane_edges = 0;
+  stack[nstack][0] = 0;
+  stack[nstack++][1] = n - 1;
+  while (nstack) {
+    auto i = stack[--nstack][0];
+    auto j = stack[nstack][1];
+    if (j - i < 2) continue;
+    auto k = split[i][j];
+    tri.tris[ntris][0] = i;
+    tri.tris[ntris][1] = k;
+    tri.tris[ntris++][2] = j;
+    if (j - i < n - 1) {
+      tri.edges[nplane_edges][0] = i;
+      tri.edges[nplane_edges++][1] = j;
+    }
+    stack[nstack][0] = i;
+    stack[nstack++][1] = k;
+    stack[nstack][0] = k;
+    stack[nstack++][1] = j;
+  }
+  return tri;
+}
+
 template <typename QualityMeasure, typename LengthMeasure>
 OMEGA_H_DEVICE Choice choose(Loop loop, QualityMeasure const& quality_measure,
     LengthMeasure const& length_measure, Real max_length_allowed) {
+  Choice choice;
+  choice.mesh = -1;
+  choice.quality = 0.0;
+  if (loop.size > MAX_EDGE_SWAP) {
+    auto tri = triangulate_loop(
+        loop, quality_measure, length_measure, max_length_allowed);
+    if (tri.quality > 0.0) {
+      choice.mesh = DP_CONFIG;
+      choice.quality = tri.quality;
+    }
+    return choice;
+  }
   auto nmeshes = swap_mesh_counts[loop.size];
   auto nmesh_tris = swap_mesh_sizes[loop.size];
   auto uniq_tris2loop_verts = swap_triangles[loop.size];
@@ -22,41 +145,22 @@ OMEGA_H_DEVICE Choice choose(Loop loop, QualityMeasure const& quality_measure,
   Real uniq_tri_quals[MAX_UNIQUE_TRIS] = {0};
   bool uniq_edgs_cached[MAX_UNIQUE_EDGES] = {false};
   Real uniq_edg_lens[MAX_UNIQUE_EDGES] = {0};
-  Choice choice;
-  choice.mesh = -1;
-  choice.quality = 0.0;
   for (Int mesh = 0; mesh < nmeshes; ++mesh) {
     Real mesh_minqual = 1.0;
     auto mesh_tris2uniq_tris = &swap_meshes[loop.size][mesh * nmesh_tris];
     for (Int mesh_tri = 0; mesh_tri < nmesh_tris; ++mesh_tri) {
       auto uniq_tri = mesh_tris2uniq_tris[mesh_tri];
       if (!uniq_tris_cached[uniq_tri]) {
-        auto tri_verts2loop_verts = uniq_tris2loop_verts[uniq_tri];
-        /* the first three tet vertices are
-           the same as the bottom triangle,
-           curling into the tet. we fill these
-           in from the triangle table for the current
-           2D mesh being explored */
-        Few<LO, 4> tet_verts2verts;
+        /* we fill in the triangle from the table
+           for the current 2D mesh being explored */
+        Few<Int, 3> tri_verts2loop_verts;
         for (Int tri_vert = 0; tri_vert < 3; ++tri_vert) {
-          auto loop_vert = tri_verts2loop_verts[tri_vert];
-          auto vert = loop.loop_verts2verts[loop_vert];
-          tet_verts2verts[tri_vert] = vert;
-        }
-        /* each triangle will support two tets,
-           one above and one below. this loop
-           forms those tets, swapping vertices
-           in between to maintain proper orientation.
-           (mfr means Region of Face of Mesh) */
-        Real tri_minqual = 1.0;
-        for (Int tri_tet = 0; tri_tet < 2; ++tri_tet) {
-          tet_verts2verts[3] = loop.eev2v[1 - tri_tet];
-          auto tet_qual = quality_measure.measure(tet_verts2verts);
-          tri_minqual = min2(tri_minqual, tet_qual);
-          swap2(tet_verts2verts[1], tet_verts2verts[2]);
+          tri_verts2loop_verts[tri_vert] =
+              uniq_tris2loop_verts[uniq_tri][tri_vert];
         }
         uniq_tris_cached[uniq_tri] = true;
-        uniq_tri_quals[uniq_tri] = tri_minqual;
+        uniq_tri_quals[uniq_tri] =
+            measure_loop_tri(loop, quality_measure, tri_verts2loop_verts);
       }
       auto tri_minqual = uniq_tri_quals[uniq_tri];
       mesh_minqual = min2(mesh_minqual, tri_minqual);
@@ -11,6 +11,13 @@ namespace Omega_h {
 
 namespace swap3d {
 
+/* loops of up to MAX_EDGE_SWAP edges are triangulated using the
+   tables in Omega_h_swap3d_tables.hpp, and larger ones of up to
+   MAX_LOOP_SIZE edges by dynamic programming
+   (see triangulate_loop() in Omega_h_swap3d_choice.hpp).
+   DP_CONFIG is the configuration that marks the latter. */
+enum { MAX_LOOP_SIZE = 16, DP_CONFIG = MAX_CONFIGS };
+
 /* by definition, the loop vertices curl
    around the edge by the right-hand rule,
    i.e. counterclockwise when looking from
@@ -18,7 +25,7 @@ namespace swap3d {
 struct Loop {
   Int size;
   Few<LO, 2> eev2v;
-  Few<LO, MAX_EDGE_SWAP> loop_verts2verts;
+  Few<LO, MAX_LOOP_SIZE> loop_verts2verts;
 };
 
 OMEGA_H_DEVICE Loop find_loop(LOs const& edges2edge_tets,
@@ -28,7 +35,7 @@ OMEGA_H_DEVICE Loop find_loop(LOs const& edges2edge_tets,
   auto begin_use = edges2edge_tets[edge];
   auto end_use = edges2edge_tets[edge + 1];
   loop.size = end_use - begin_use;
-  if (loop.size > MAX_EDGE_SWAP) return loop;
+  if (loop.size > MAX_LOOP_SIZE) return loop;
   OMEGA_H_CHECK(loop.size >= 3);
   for (Int eev = 0; eev < 2; ++eev) {
     loop.eev2v[eev] = edge_verts2verts[edge * 2 + eev];
@@ -36,8 +43,8 @@ OMEGA_H_DEVICE Loop find_loop(LOs const& edges2edge_tets,
   /* collect the endpoints of the loop edges.
      each pair of endpoints is chosen to be pointing
      in the direction of curl. */
-  Few<LO, 2> tmp_edges[MAX_EDGE_SWAP];
-  for (Int i = 0; i < MAX_EDGE_SWAP; ++i) {
+  Few<LO, 2> tmp_edges[MAX_LOOP_SIZE];
+  for (Int i = 0; i < MAX_LOOP_SIZE; ++i) {
     tmp_edges[i][0] = tmp_edges[i][1] = -1;
   }
   for (Int loop_edge = 0; loop_edge < loop.size; ++loop_edge) {
@@ -62,7 +69,7 @@ OMEGA_H_DEVICE Loop find_loop(LOs const& edges2edge_tets,
    * The following code uses insertion sort to
    * order the edges around the loop by matching their
    * endpoints.
-   * Remember, there are at most 7 edges to sort. */
+   * Remember, there are at most MAX_LOOP_SIZE edges to sort. */
   for (Int i = 0; i < loop.size - 1; ++i) {
     Int j;
     for (j = i + 1; j < loop.size; ++j) {
@@ -36,7 +36,7 @@ static void swap3d_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
     }
     auto loop = swap3d::find_loop(edges2edge_tets, edge_tets2tets,
         edge_tet_codes, edge_verts2verts, tet_verts2verts, edge);
-    if (loop.size > swap3d::MAX_EDGE_SWAP) {
+    if (loop.size > swap3d::MAX_LOOP_SIZE) {
       cand_configs_w[cand] = -1;
       cand_quals_w[cand] = -1.0;
       return;
@@ -48,7 +48,7 @@ static void swap3d_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
     cand_configs_w[cand] = static_cast<I8>(choice.mesh);
     cand_quals_w[cand] = choice.quality;
   };
-  parallel_for(ncands, f, "swap3d_qualities");
+  parallel_for_dynamic(ncands, f, "swap3d_qualities");
   *cand_quals = cand_quals_w;
   *cand_configs = cand_configs_w;
   *cand_quals =
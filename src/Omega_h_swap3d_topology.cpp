@@ -3,7 +3,10 @@
 #include "Omega_h_loop.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_metric.hpp"
+#include "Omega_h_quality.hpp"
 #include "Omega_h_scan.hpp"
+#include "Omega_h_swap3d_choice.hpp"
 #include "Omega_h_swap3d_loop.hpp"
 #include "Omega_h_swap3d_tables.hpp"
 
@@ -21,8 +24,10 @@ HostFew<LOs, 4> swap3d_keys_to_prods(Mesh* mesh, LOs keys2edges) {
   auto f = OMEGA_H_LAMBDA(LO key) {
     auto edge = keys2edges[key];
     auto loop_size = edges2ntets[edge];
-    auto nplane_tris = swap3d::swap_mesh_sizes[loop_size];
-    auto nplane_edges = swap3d::nedges[loop_size];
+    /* every triangulation of an N-sided polygon has
+       (N - 2) triangles and (N - 3) interior edges */
+    auto nplane_tris = loop_size - 2;
+    auto nplane_edges = loop_size - 3;
     auto nprod_edges = nplane_edges;
     auto nprod_tris = nplane_tris + 2 * nplane_edges;
     auto nprod_tets = 2 * nplane_tris;
@@ -38,14 +43,18 @@ HostFew<LOs, 4> swap3d_keys_to_prods(Mesh* mesh, LOs keys2edges) {
   return keys2prods;
 }
 
-HostFew<LOs, 4> swap3d_topology(Mesh* mesh, LOs keys2edges,
-    Read<I8> edge_configs, HostFew<LOs, 4> keys2prods) {
+template <Int metric_dim>
+static HostFew<LOs, 4> swap3d_topology_tmpl(Mesh* mesh, AdaptOpts const& opts,
+    LOs keys2edges, Read<I8> edge_configs, HostFew<LOs, 4> keys2prods) {
   auto edges2tets = mesh->ask_up(EDGE, REGION);
   auto edges2edge_tets = edges2tets.a2ab;
   auto edge_tets2tets = edges2tets.ab2b;
   auto edge_tet_codes = edges2tets.codes;
   auto edge_verts2verts = mesh->ask_verts_of(EDGE);
   auto tet_verts2verts = mesh->ask_verts_of(REGION);
+  auto quality_measure = MetricElementQualities<3, metric_dim>(mesh);
+  auto length_measure = MetricEdgeLengths<3, metric_dim>(mesh);
+  auto max_length = opts.max_length_allowed;
   HostFew<Write<LO>, 4> prod_verts2verts_w;
   for (Int prod_dim = EDGE; prod_dim <= REGION; ++prod_dim) {
     prod_verts2verts_w[prod_dim] =
@@ -57,13 +66,28 @@ HostFew<LOs, 4> swap3d_topology(Mesh* mesh, LOs keys2edges,
     auto config = edge_configs[edge];
     auto loop = swap3d::find_loop(edges2edge_tets, edge_tets2tets,
         edge_tet_codes, edge_verts2verts, tet_verts2verts, edge);
-    auto nplane_tris = swap3d::swap_mesh_sizes[loop.size];
-    auto nplane_edges = swap3d::nedges[loop.size];
+    auto nplane_tris = loop.size - 2;
+    auto nplane_edges = loop.size - 3;
+    /* loops beyond the tables are triangulated again here,
+       which chooses the same triangulation that swap3d_qualities()
+       measured because it sees the same vertices and metrics */
+    swap3d::LoopTriangulation dp_tri;
+    if (config == swap3d::DP_CONFIG) {
+      dp_tri = swap3d::triangulate_loop(
+          loop, quality_measure, length_measure, max_length);
+      OMEGA_H_CHECK(dp_tri.quality > 0.0);
+    }
     for (Int plane_edge = 0; plane_edge < nplane_edges; ++plane_edge) {
-      auto unique_edge = swap3d::edges2unique[loop.size][config][plane_edge];
       Few<LO, 2> plane_edge_verts;
       for (Int pev = 0; pev < 2; ++pev) {
-        auto loop_vert = swap3d::unique_edges[loop.size][unique_edge][pev];
+        Int loop_vert;
+        if (config == swap3d::DP_CONFIG) {
+          loop_vert = dp_tri.edges[plane_edge][pev];
+        } else {
+          auto unique_edge =
+              swap3d::edges2unique[loop.size][config][plane_edge];
+          loop_vert = swap3d::unique_edges[loop.size][unique_edge][pev];
+        }
         auto vert = loop.loop_verts2verts[loop_vert];
         plane_edge_verts[pev] = vert;
       }
@@ -84,11 +108,16 @@ HostFew<LOs, 4> swap3d_topology(Mesh* mesh, LOs keys2edges,
       }
     }
     for (Int plane_tri = 0; plane_tri < nplane_tris; ++plane_tri) {
-      auto uniq_tri =
-          swap3d::swap_meshes[loop.size][config * nplane_tris + plane_tri];
       Few<LO, 3> plane_tri_verts;
       for (Int pfv = 0; pfv < 3; ++pfv) {
-        auto loop_vert = swap3d::swap_triangles[loop.size][uniq_tri][pfv];
+        Int loop_vert;
+        if (config == swap3d::DP_CONFIG) {
+          loop_vert = dp_tri.tris[plane_tri][pfv];
+        } else {
+          auto uniq_tri =
+              swap3d::swap_meshes[loop.size][config * nplane_tris + plane_tri];
+          loop_vert = swap3d::swap_triangles[loop.size][uniq_tri][pfv];
+        }
         auto vert = loop.loop_verts2verts[loop_vert];
         plane_tri_verts[pfv] = vert;
       }
@@ -118,4 +147,19 @@ HostFew<LOs, 4> swap3d_topology(Mesh* mesh, LOs keys2edges,
   return prod_verts2verts;
 }
 
+HostFew<LOs, 4> swap3d_topology(Mesh* mesh, AdaptOpts const& opts,
+    LOs keys2edges, Read<I8> edge_configs, HostFew<LOs, 4> keys2prods) {
+  auto metrics = mesh->get_array<Real>(VERT, "metric");
+  auto metric_dim = get_metrics_dim(mesh->nverts(), metrics);
+  if (metric_dim == 3) {
+    return swap3d_topology_tmpl<3>(
+        mesh, opts, keys2edges, edge_configs, keys2prods);
+  }
+  if (metric_dim == 1) {
+    return swap3d_topology_tmpl<1>(
+        mesh, opts, keys2edges, edge_configs, keys2prods);
+  }
+  Omega_h_fail("swap3d_topology: unsupported metric dimension\n");
+}
+
 }  // end namespace Omega_h
@@ -2,6 +2,7 @@
 #define OMEGA_H_TAG_HPP
 
 #include <array>
+#include <functional>
 #include <set>
 #include <string>
 
@@ -32,10 +33,15 @@ class Tag : public TagBase {
   Tag(std::string const& name_in, Int ncomps_in);
   Read<T> array() const;
   void set_array(Read<T> array_in);
+  /* the array will be given by (loader) when first asked for */
+  void set_loader(std::function<Read<T>()> loader_in);
+  /* false while the loader has not been run yet */
+  bool is_loaded() const;
   virtual Omega_h_Type type() const override;
 
  private:
-  Read<T> array_;
+  mutable Read<T> array_;
+  mutable std::function<Read<T>()> loader_;
 };
 
 template <typename T>
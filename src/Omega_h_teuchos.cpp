@@ -113,14 +113,18 @@ void update_adapt_opts(AdaptOpts* opts, Teuchos::ParameterList const& pl) {
   set_if_given(&opts->nlength_histogram_bins, pl, "Length Histogram Bin Count");
   set_if_given(
       &opts->nquality_histogram_bins, pl, "Quality Histogram Bin Count");
+  /* residual reduction factor of the conjugate gradient smoothing */
+  set_if_given(&opts->snap_smooth_tolerance, pl, "Snap Smooth Tolerance");
+  set_if_given(
+      &opts->snap_smooth_max_iters, pl, "Snap Smooth Max Iterations");
 #ifdef OMEGA_H_USE_EGADS
   set_if_given(&opts->should_smooth_snap, pl, "Smooth Snap");
-  set_if_given(&opts->snap_smooth_tolerance, pl, "Snap Smooth Tolerance");
 #endif
   set_if_given(&opts->should_refine, pl, "Refine");
   set_if_given(&opts->should_coarsen, pl, "Coarsen");
   set_if_given(&opts->should_swap, pl, "Swap");
   set_if_given(&opts->should_coarsen_slivers, pl, "Coarsen Slivers");
+  set_if_given(&opts->should_refine_in_batch, pl, "Refine In Batch");
   if (pl.isSublist("Transfer")) {
     update_transfer_opts(&opts->xfer_opts, pl.sublist("Transfer"));
   }
@@ -409,6 +409,93 @@ void transfer_refine(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
   end_code();
 }
 
+template <typename T>
+static void transfer_inherit_refine_batch_tmpl(Mesh* old_mesh,
+    Mesh* new_mesh, Int prod_dim, Read<I8> prods2parent_dims,
+    LOs prods2parents, LOs prods2new_ents, LOs same_ents2old_ents,
+    LOs same_ents2new_ents, TagBase const* tagbase) {
+  auto const& name = tagbase->name();
+  auto ncomps = tagbase->ncomps();
+  auto nprods = prods2parents.size();
+  auto prod_data = Write<T>(nprods * ncomps);
+  for (Int parent_dim = prod_dim; parent_dim <= old_mesh->dim();
+       ++parent_dim) {
+    auto parent_data = old_mesh->get_array<T>(parent_dim, name);
+    auto f = OMEGA_H_LAMBDA(LO prod) {
+      if (prods2parent_dims[prod] != parent_dim) return;
+      auto parent = prods2parents[prod];
+      for (Int comp = 0; comp < ncomps; ++comp) {
+        prod_data[prod * ncomps + comp] = parent_data[parent * ncomps + comp];
+      }
+    };
+    parallel_for(nprods, f, "transfer_inherit_refine_batch");
+  }
+  transfer_common(old_mesh, new_mesh, prod_dim, same_ents2old_ents,
+      same_ents2new_ents, prods2new_ents, tagbase, Read<T>(prod_data));
+}
+
+static void transfer_inherit_refine_batch(Mesh* old_mesh, Mesh* new_mesh,
+    Int prod_dim, Read<I8> prods2parent_dims, LOs prods2parents,
+    LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents,
+    TagBase const* tagbase) {
+  switch (tagbase->type()) {
+    case OMEGA_H_I8:
+      transfer_inherit_refine_batch_tmpl<I8>(old_mesh, new_mesh, prod_dim,
+          prods2parent_dims, prods2parents, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, tagbase);
+      break;
+    case OMEGA_H_I32:
+      transfer_inherit_refine_batch_tmpl<I32>(old_mesh, new_mesh, prod_dim,
+          prods2parent_dims, prods2parents, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, tagbase);
+      break;
+    case OMEGA_H_I64:
+      transfer_inherit_refine_batch_tmpl<I64>(old_mesh, new_mesh, prod_dim,
+          prods2parent_dims, prods2parents, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, tagbase);
+      break;
+    case OMEGA_H_F64:
+      transfer_inherit_refine_batch_tmpl<Real>(old_mesh, new_mesh, prod_dim,
+          prods2parent_dims, prods2parents, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, tagbase);
+      break;
+  }
+}
+
+/* the batched refinement in Omega_h_refine_batch.cpp does not
+   conserve, so element densities and pointwise fields are
+   simply inherited from the parent element like other fields */
+void transfer_refine_batch(Mesh* old_mesh, TransferOpts const& opts,
+    Mesh* new_mesh, Int prod_dim, Read<I8> prods2parent_dims,
+    LOs prods2parents, LOs prods2new_ents, LOs same_ents2old_ents,
+    LOs same_ents2new_ents) {
+  begin_code("transfer_refine_batch");
+  OMEGA_H_CHECK(prod_dim > VERT);
+  auto dim = old_mesh->dim();
+  for (Int i = 0; i < old_mesh->ntags(prod_dim); ++i) {
+    auto tagbase = old_mesh->get_tag(prod_dim, i);
+    if (should_inherit(old_mesh, opts, prod_dim, tagbase) ||
+        (prod_dim == dim &&
+            (should_transfer_density(old_mesh, opts, dim, tagbase) ||
+                should_fit(old_mesh, opts, dim, tagbase)))) {
+      transfer_inherit_refine_batch(old_mesh, new_mesh, prod_dim,
+          prods2parent_dims, prods2parents, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, tagbase);
+    }
+  }
+  if (prod_dim == EDGE) {
+    transfer_length(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
+        prods2new_ents);
+  }
+  if (prod_dim == dim) {
+    transfer_size(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
+        prods2new_ents);
+    transfer_quality(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
+        prods2new_ents);
+  }
+  end_code();
+}
+
 template <typename T>
 static void transfer_inherit_coarsen_tmpl(Mesh* old_mesh, Mesh* new_mesh,
     Adj keys2doms, Int prod_dim, LOs prods2new_ents, LOs same_ents2old_ents,
@@ -36,6 +36,11 @@ void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh, LOs keys2edges,
     Int prod_dim, LOs keys2prods, LOs prods2new_ents, LOs same_ents2old_ents,
     LOs same_ents2new_ents, TagBase const* tagbase);
 
+void transfer_refine_batch(Mesh* old_mesh, TransferOpts const& opts,
+    Mesh* new_mesh, Int prod_dim, Read<I8> prods2parent_dims,
+    LOs prods2parents, LOs prods2new_ents, LOs same_ents2old_ents,
+    LOs same_ents2new_ents);
+
 void transfer_coarsen(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     LOs keys2verts, Adj keys2doms, Int prod_dim, LOs prods2new_ents,
     LOs same_ents2old_ents, LOs same_ents2new_ents);
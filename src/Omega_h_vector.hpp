@@ -14,8 +14,8 @@ class Vector : public Few<Real, n> {
   OMEGA_H_INLINE void operator=(Vector<n> const& rhs) volatile {
     Few<Real, n>::operator=(rhs);
   }
-  OMEGA_H_INLINE void operator=(Vector<Scalar,n> const& rhs) {
-    Few<Scalar, n>::operator=(rhs);
+  OMEGA_H_INLINE void operator=(Vector<n> const& rhs) {
+    Few<Real, n>::operator=(rhs);
   }
   OMEGA_H_INLINE Vector(Vector<n> const& rhs) : Few<Real, n>(rhs) {}
   OMEGA_H_INLINE Vector(const volatile Vector<n>& rhs) : Few<Real, n>(rhs) {}
@@ -3,22 +3,31 @@
 #include "Omega_h_assoc.hpp"
 #include "Omega_h_bbox.hpp"
 #include "Omega_h_build.hpp"
+#include "Omega_h_class.hpp"
 #include "Omega_h_compare.hpp"
 #include "Omega_h_confined.hpp"
 #include "Omega_h_eigen.hpp"
 #include "Omega_h_hilbert.hpp"
 #include "Omega_h_inertia.hpp"
+#include "Omega_h_laplace.hpp"
 #include "Omega_h_lie.hpp"
 #include "Omega_h_linpart.hpp"
 #include "Omega_h_loop.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
+#include "Omega_h_migrate.hpp"
 #include "Omega_h_most_normal.hpp"
+#include "Omega_h_pool.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_rebalance.hpp"
 #include "Omega_h_recover.hpp"
+#include "Omega_h_refine.hpp"
+#include "Omega_h_refine_batch.hpp"
 #include "Omega_h_refine_qualities.hpp"
 #include "Omega_h_scan.hpp"
 #include "Omega_h_shape.hpp"
 #include "Omega_h_sort.hpp"
+#include "Omega_h_swap.hpp"
 #include "Omega_h_swap2d.hpp"
 #include "Omega_h_swap3d_choice.hpp"
 #include "Omega_h_swap3d_loop.hpp"
@@ -29,6 +38,10 @@
 #include "Omega_h_expr.hpp"
 #endif
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -302,6 +315,48 @@ static void test_sort() {
     LOs perm = sort_by_keys(a, 3);
     OMEGA_H_CHECK(perm == LOs({1, 0, 2}));
   }
+  {
+    GOs a({-1, 1, 0, 1, -1, -1, 0, 0});
+    LOs perm = sort_by_keys(a, 2);
+    OMEGA_H_CHECK(perm == LOs({2, 0, 3, 1}));
+  }
+  {
+    GOs a({GO(1) << 40, -(GO(1) << 40), 3, GO(1) << 33});
+    LOs perm = sort_by_keys(a);
+    OMEGA_H_CHECK(perm == LOs({1, 2, 3, 0}));
+  }
+}
+
+template <typename T, Int N>
+static void test_sort_vs_stable_sort() {
+  LO n = 5000;
+  HostWrite<T> h_keys(n * N);
+  /* a small range of values gives plenty of ties */
+  for (LO i = 0; i < n * N; ++i) {
+    h_keys[i] = T((I64(i) * 7919 + (I64(i) % 13) * 104729) % 37) - 18;
+  }
+  h_keys[0] = ArithTraits<T>::max();
+  h_keys[N] = ArithTraits<T>::min();
+  auto keys = Read<T>(h_keys.write());
+  std::vector<LO> expected(static_cast<std::size_t>(n));
+  for (LO i = 0; i < n; ++i) expected[std::size_t(i)] = i;
+  std::stable_sort(expected.begin(), expected.end(), [&](LO a, LO b) {
+    for (Int j = 0; j < N; ++j) {
+      if (h_keys[a * N + j] != h_keys[b * N + j]) {
+        return h_keys[a * N + j] < h_keys[b * N + j];
+      }
+    }
+    return false;
+  });
+  HostRead<LO> perm(sort_by_keys(keys, N));
+  for (LO i = 0; i < n; ++i) OMEGA_H_CHECK(perm[i] == expected[std::size_t(i)]);
+}
+
+static void test_sort_vs_stable_sort() {
+  test_sort_vs_stable_sort<LO, 1>();
+  test_sort_vs_stable_sort<LO, 3>();
+  test_sort_vs_stable_sort<GO, 2>();
+  test_sort_vs_stable_sort<GO, 4>();
 }
 
 static void test_scan() {
@@ -313,6 +368,46 @@ static void test_scan() {
     LOs scanned = offset_scan(Read<I8>(3, 1));
     OMEGA_H_CHECK(scanned == Read<LO>(4, 0, 1));
   }
+  {
+    /* large enough to be split over several threads */
+    LOs scanned = offset_scan(LOs(10007, 2));
+    OMEGA_H_CHECK(scanned == Read<LO>(10008, 0, 2));
+  }
+  {
+    HostWrite<LO> h_a(10007);
+    for (LO i = 0; i < h_a.size(); ++i) h_a[i] = (i % 3) ? -1 : i;
+    Write<LO> a(h_a);
+    fill_right(a);
+    HostRead<LO> h_b(a);
+    for (LO i = 0; i < h_b.size(); ++i) OMEGA_H_CHECK(h_b[i] == i / 3 * 3);
+  }
+}
+
+static void test_parallel_for_dynamic() {
+  LO n = 10007;
+  Write<LO> hits(n, 0);
+  auto f = OMEGA_H_LAMBDA(LO i) { hits[i] += 1; };
+  parallel_for_dynamic(n, f, "test_parallel_for_dynamic", 3);
+  OMEGA_H_CHECK(LOs(hits) == LOs(n, 1));
+}
+
+static void test_pool() {
+#ifndef OMEGA_H_USE_KOKKOSCORE
+  auto was_enabled = is_pooling_enabled();
+  disable_pooling();
+  enable_pooling();
+  auto hits = get_pool_hits();
+  auto misses = get_pool_misses();
+  auto p = Write<LO>(100, 0).data();
+  OMEGA_H_CHECK(get_pool_misses() == misses + 1);
+  OMEGA_H_CHECK(get_pool_cached_bytes() == 512);
+  /* same size class, gets the same block back */
+  OMEGA_H_CHECK(Write<Real>(60, 0.0).data() == reinterpret_cast<Real*>(p));
+  OMEGA_H_CHECK(get_pool_hits() == hits + 1);
+  disable_pooling();
+  OMEGA_H_CHECK(get_pool_cached_bytes() == 0);
+  if (was_enabled) enable_pooling();
+#endif
 }
 
 static void test_fan_and_funnel() {
@@ -523,6 +618,74 @@ static void test_find_unique() {
                 LOs({0, 1, 3, 0, 1, 2, 2, 3}));
 }
 
+static void test_dedup_by_hashing(Library* lib, Omega_h_Family family) {
+  auto mesh = build_box(lib->world(), family, 1.0, 1.0, 1.0, 3, 2, 2);
+  auto ev2v = mesh.ask_elem_verts();
+  for (Int low_dim = 1; low_dim < 3; ++low_dim) {
+    auto sorted = find_unique(ev2v, family, 3, low_dim, DEDUP_BY_SORTING);
+    auto hashed = find_unique(ev2v, family, 3, low_dim, DEDUP_BY_HASHING);
+    OMEGA_H_CHECK(sorted == hashed);
+    auto down = mesh.ask_down(3, low_dim);
+    auto hashed_down = reflect_down_by_hashing(
+        ev2v, mesh.ask_verts_of(low_dim), family, 3, low_dim);
+    OMEGA_H_CHECK(down.ab2b == hashed_down.ab2b);
+    OMEGA_H_CHECK(down.codes == hashed_down.codes);
+  }
+}
+
+static void test_dedup_by_hashing(Library* lib) {
+  test_dedup_by_hashing(lib, OMEGA_H_SIMPLEX);
+  test_dedup_by_hashing(lib, OMEGA_H_HYPERCUBE);
+}
+
+static void test_update_up_adj(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  add_implied_metric_tag(&mesh);
+  /* halve the desired size so that long edges get refined */
+  auto metrics = mesh.get_array<Real>(VERT, "metric");
+  mesh.set_tag(VERT, "metric", multiply_each_by(metrics, 4.0));
+  for (Int dim = 0; dim < mesh.dim(); ++dim) mesh.ask_up(dim, dim + 1);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+  for (Int dim = 0; dim < mesh.dim(); ++dim) {
+    OMEGA_H_CHECK(mesh.has_adj(dim, dim + 1));
+    auto up = mesh.ask_up(dim, dim + 1);
+    auto deg = simplex_degree(dim + 1, dim);
+    auto down = mesh.ask_down(dim + 1, dim);
+    auto derived = invert_adj(down, deg, mesh.nents(dim));
+    OMEGA_H_CHECK(up.a2ab == derived.a2ab);
+    OMEGA_H_CHECK(up.ab2b == derived.ab2b);
+    OMEGA_H_CHECK(up.codes == derived.codes);
+  }
+}
+
+static void test_refine_in_batch(Library* lib, Int dim) {
+  auto z = (dim == 3) ? 1. : 0.;
+  auto nz = (dim == 3) ? 2 : 0;
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., z, 2, 2, nz);
+  add_implied_metric_tag(&mesh);
+  auto metrics = mesh.get_array<Real>(VERT, "metric");
+  mesh.set_tag(VERT, "metric", multiply_each_by(metrics, 4.0));
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.should_refine_in_batch = true;
+  OMEGA_H_CHECK(can_refine_in_batch(&mesh, opts));
+  auto nverts = mesh.nverts();
+  auto ncands = get_sum(each_gt(mesh.ask_lengths(), opts.max_length_desired));
+  OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+  /* every long edge is split in the one rebuild */
+  OMEGA_H_CHECK(mesh.nverts() == nverts + ncands);
+  /* a conforming subdivision of the box has Euler characteristic one */
+  LO euler = 0;
+  for (Int d = 0; d <= dim; ++d) {
+    euler += ((d % 2) ? -1 : 1) * mesh.nents(d);
+  }
+  OMEGA_H_CHECK(euler == 1);
+  OMEGA_H_CHECK(are_close(get_sum(mesh.ask_sizes()), 1.0));
+  OMEGA_H_CHECK(get_min(mesh.ask_qualities()) >= opts.min_quality_allowed);
+}
+
 static void test_hilbert() {
   /* this is the original test from Skilling's paper */
   hilbert::coord_t X[3] = {5, 10, 20};  // any position in 32x32x32 cube
@@ -705,6 +868,9 @@ static void test_file_components() {
   write_array(stream, ac);
   Read<Real> ad(n, 0, d);
   write_array(stream, ad);
+  /* large enough to be compressed in several chunks */
+  Read<Real> ae(300 * 1000, 0, d);
+  write_array(stream, ae);
   write(stream, s);
   I8 a2;
   read_value(stream, a2);
@@ -730,6 +896,9 @@ static void test_file_components() {
   Read<Real> ad2;
   read_array(stream, ad2, is_compressed);
   OMEGA_H_CHECK(ad2 == ad);
+  Read<Real> ae2;
+  read_array(stream, ae2, is_compressed);
+  OMEGA_H_CHECK(ae2 == ae);
   std::string s2;
   read(stream, s2);
   OMEGA_H_CHECK(s == s2);
@@ -823,6 +992,341 @@ static void test_compare_meshes(Library* lib) {
   OMEGA_H_CHECK(!(a == b));
 }
 
+static void test_tag_lookup(Library* lib) {
+  auto mesh = Mesh(lib);
+  build_box_internal(&mesh, OMEGA_H_SIMPLEX, 1., 1., 0., 1, 1, 0);
+  auto ntags = mesh.ntags(VERT);
+  mesh.add_tag<I8>(VERT, "a", 1, Read<I8>(mesh.nverts(), 1));
+  mesh.add_tag<I8>(VERT, "b", 1, Read<I8>(mesh.nverts(), 2));
+  mesh.add_tag<I8>(VERT, "c", 1, Read<I8>(mesh.nverts(), 3));
+  mesh.remove_tag(VERT, "b");
+  OMEGA_H_CHECK(!mesh.has_tag(VERT, "b"));
+  OMEGA_H_CHECK(mesh.ntags(VERT) == ntags + 2);
+  OMEGA_H_CHECK(mesh.get_tag(VERT, ntags + 1)->name() == "c");
+  OMEGA_H_CHECK(mesh.get_array<I8>(VERT, "c") == Read<I8>(mesh.nverts(), 3));
+  mesh.set_tag(VERT, "a", Read<I8>(mesh.nverts(), 4));
+  OMEGA_H_CHECK(mesh.get_array<I8>(VERT, "a") == Read<I8>(mesh.nverts(), 4));
+  Mesh copy = mesh;
+  copy.remove_tag(VERT, "a");
+  OMEGA_H_CHECK(mesh.has_tag(VERT, "a"));
+  OMEGA_H_CHECK(copy.get_tag(VERT, ntags)->name() == "c");
+  OMEGA_H_CHECK(copy.has_tag(VERT, "c"));
+}
+
+static void test_limit_gradation(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  /* one vertex asks for a size four orders of magnitude smaller */
+  auto h_metrics = HostWrite<Real>(mesh.nverts());
+  for (LO v = 0; v < mesh.nverts(); ++v) {
+    h_metrics[v] = metric_eigenvalue_from_length((v == 0) ? 1e-4 : 1.0);
+  }
+  auto metrics = Reals(h_metrics.write());
+  auto limited = limit_metric_gradation(&mesh, metrics, 1.0, 1e-3, false);
+  OMEGA_H_CHECK(get_max(limited) == get_max(metrics));
+  OMEGA_H_CHECK(!are_close(limited, metrics));
+  /* limiting again changes nothing: every edge already
+     satisfies the gradation bound */
+  auto relimited = limit_metric_gradation(&mesh, limited, 1.0, 1e-3, false);
+  OMEGA_H_CHECK(are_close(relimited, limited, 1e-3));
+  auto coords = mesh.coords();
+  auto ev2v = mesh.ask_verts_of(EDGE);
+  auto edges_are_graded = Write<I8>(mesh.nedges());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    auto v0 = ev2v[e * 2 + 0];
+    auto v1 = ev2v[e * 2 + 1];
+    auto h0 = metric_length_from_eigenvalue(limited[v0]);
+    auto h1 = metric_length_from_eigenvalue(limited[v1]);
+    auto l = norm(get_vector<2>(coords, v1) - get_vector<2>(coords, v0));
+    auto hmin = min2(h0, h1);
+    auto hmax = max2(h0, h1);
+    edges_are_graded[e] = I8(hmax <= (hmin + l) * (1.0 + 1e-2));
+  };
+  parallel_for(mesh.nedges(), f);
+  OMEGA_H_CHECK(get_min(Read<I8>(edges_are_graded)) == 1);
+}
+
+static void test_laplacian_cg(Library* lib, Int dim) {
+  auto n = (dim == 3) ? 8 : 24;
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., n, n,
+      (dim == 3) ? n : 0);
+  /* the structured boxes are symmetric enough that any linear field is
+     harmonic, so boundary values of x must extend to x everywhere */
+  auto x = get_component(mesh.coords(), dim, 0);
+  auto interior = mark_by_class_dim(&mesh, VERT, dim);
+  auto initial_w = Write<Real>(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) { initial_w[v] = interior[v] ? 0.0 : x[v]; };
+  parallel_for(mesh.nverts(), f);
+  auto initial = Reals(initial_w);
+  auto mg = solve_laplacian_cg(&mesh, initial, 1, 1e-10);
+  OMEGA_H_CHECK(are_close(mg, x, 1e-8, 1e-8));
+  auto pcg = solve_laplacian_cg(&mesh, initial, 1, 1e-10, false);
+  OMEGA_H_CHECK(are_close(pcg, x, 1e-8, 1e-8));
+  /* the iteration cap stops the solve short of the tolerance */
+  auto capped = solve_laplacian_cg(&mesh, initial, 1, 1e-10, false, 2);
+  OMEGA_H_CHECK(!are_close(capped, x, 1e-8, 1e-8));
+  /* the width components are solved independently */
+  auto initial2 = Write<Real>(mesh.nverts() * 2);
+  set_component(initial2, initial, 2, 0);
+  set_component(initial2, multiply_each_by(initial, 2.0), 2, 1);
+  auto mg2 = solve_laplacian_cg(&mesh, initial2, 2, 1e-10);
+  OMEGA_H_CHECK(are_close(get_component(mg2, 2, 0), x, 1e-8, 1e-8));
+  OMEGA_H_CHECK(are_close(
+      get_component(mg2, 2, 1), multiply_each_by(x, 2.0), 1e-8, 1e-8));
+}
+
+static void test_smooth_snap_warp(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  /* a linear warp is harmonic on the structured box */
+  auto exact = multiply_each_by(mesh.coords(), 0.1);
+  auto interior = mark_by_class_dim(&mesh, VERT, 2);
+  auto warp_w = Write<Real>(mesh.nverts() * 2);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    for (Int c = 0; c < 2; ++c) {
+      warp_w[v * 2 + c] = interior[v] ? 0.0 : exact[v * 2 + c];
+    }
+  };
+  parallel_for(mesh.nverts(), f);
+  auto warp = Reals(warp_w);
+  auto smooth = smooth_snap_warp(&mesh, warp, opts);
+  OMEGA_H_CHECK(are_close(smooth, exact, 1e-4, 1e-4));
+  /* the iteration cap stops the smoothing short of the tolerance */
+  opts.snap_smooth_max_iters = 1;
+  auto capped = smooth_snap_warp(&mesh, warp, opts);
+  OMEGA_H_CHECK(!are_close(capped, exact, 1e-4, 1e-4));
+}
+
+static void test_inverse_dist(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 2, 2, 0);
+  for (Int d = 0; d <= mesh.dim(); ++d) {
+    auto globals = mesh.globals(d);
+    OMEGA_H_CHECK(mesh.ask_inverse_dist(d).exch(globals, 1) == globals);
+    OMEGA_H_CHECK(mesh.sync_array(d, globals, 1) == globals);
+    mesh.set_owners(d, mesh.ask_owners(d));
+    OMEGA_H_CHECK(mesh.ask_inverse_dist(d).exch(globals, 1) == globals);
+  }
+}
+
+static void test_exch_tags(Library* lib) {
+  LO n = 5;
+  auto dist = Dist(lib->self(), Remotes(Read<I32>(n, 0), LOs(n, n - 1, -1)), n);
+  Tag<I8> a("a", 1);
+  a.set_array(Read<I8>({1, 2, 3, 4, 5}));
+  Tag<I64> b("b", 2);
+  b.set_array(Read<I64>(n * 2, 0, I64(1) << 40));
+  Tag<Real> c("c", 3);
+  c.set_array(Reals({0.5, 0.75, 1.0, 1.25, 1.5, 1.75, 2.0, 2.25, 2.5, 2.75,
+      3.0, 3.25, 3.5, 3.75, 4.0}));
+  auto out = exch_tags(dist, {&a, &b, &c});
+  OMEGA_H_CHECK(out.size() == 3);
+  OMEGA_H_CHECK(out[1]->name() == "b" && out[1]->ncomps() == 2);
+  OMEGA_H_CHECK(as<I8>(out[0].get())->array() == dist.exch(a.array(), 1));
+  OMEGA_H_CHECK(as<I64>(out[1].get())->array() == dist.exch(b.array(), 2));
+  OMEGA_H_CHECK(as<Real>(out[2].get())->array() == dist.exch(c.array(), 3));
+  OMEGA_H_CHECK(as<I8>(out[0].get())->array() == Read<I8>({5, 4, 3, 2, 1}));
+}
+
+static void test_exch_begin(Library* lib) {
+  LO n = 4;
+  auto dist = Dist(lib->self(), Remotes(Read<I32>(n, 0), LOs({2, 0, 3, 1})), n);
+  auto a = LOs(n, 0, 1);
+  auto b = Reals({0.5, 1.5, 2.5, 3.5});
+  auto a_request = dist.exch_begin(a, 1);
+  auto b_request = dist.exch_begin(b, 1);
+  OMEGA_H_CHECK(dist.exch_end(b_request) == dist.exch(b, 1));
+  OMEGA_H_CHECK(dist.exch_end(a_request) == LOs({1, 3, 0, 2}));
+  OMEGA_H_CHECK(a_request.wait() == LOs({1, 3, 0, 2}));
+  /* a request dropped without waiting completes its own messages */
+  { auto dropped = dist.exch_begin(b, 1); }
+  OMEGA_H_CHECK(dist.exch(a, 1) == LOs({1, 3, 0, 2}));
+}
+
+#ifndef OMEGA_H_USE_MPI
+static void test_comm_threads(Library* lib) {
+  run_comm_threads(lib, 4, [](CommPtr comm) {
+    auto rank = comm->rank();
+    OMEGA_H_CHECK(comm->size() == 4);
+    OMEGA_H_CHECK(comm->allreduce(rank, OMEGA_H_SUM) == 6);
+    OMEGA_H_CHECK(comm->allreduce(rank, OMEGA_H_MAX) == 3);
+    OMEGA_H_CHECK(comm->exscan(GO(rank), OMEGA_H_SUM) == rank * (rank - 1) / 2);
+    auto halves = comm->split(rank % 2, -rank);
+    OMEGA_H_CHECK(halves->size() == 2 && halves->rank() == 1 - rank / 2);
+    /* around a ring, each rank sends (rank + 1) copies of its rank */
+    auto next = (rank + 1) % 4;
+    auto prev = (rank + 3) % 4;
+    auto ring = comm->graph(Read<I32>({next}));
+    OMEGA_H_CHECK(ring->sources() == Read<I32>({prev}));
+    auto recvd = ring->alltoallv(Read<I32>(rank + 1, rank),
+        LOs({0, rank + 1}), LOs({0, prev + 1}), 1);
+    OMEGA_H_CHECK(recvd == Read<I32>(prev + 1, prev));
+    OMEGA_H_CHECK(ring->allgather(rank) == Read<I32>({prev}));
+    auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+    OMEGA_H_CHECK(mesh.nelems() < 32);
+    OMEGA_H_CHECK(mesh.nglobal_ents(FACE) == 32);
+    mesh.set_parting(OMEGA_H_GHOSTED);
+    mesh.set_parting(OMEGA_H_ELEM_BASED);
+    OMEGA_H_CHECK(mesh.nglobal_ents(FACE) == 32);
+    OMEGA_H_CHECK(mesh.nglobal_ents(VERT) == 25);
+  });
+}
+
+static void test_sync_tags(Library* lib) {
+  run_comm_threads(lib, 4, [](CommPtr comm) {
+    auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+    mesh.set_parting(OMEGA_H_GHOSTED);
+    /* copies disagree with their owners until synced */
+    auto rank = Real(comm->rank());
+    auto coords = add_to_each(mesh.coords(), rank);
+    auto lengths = Reals(mesh.nedges(), rank);
+    mesh.set_tag(VERT, "coordinates", coords, true);
+    mesh.add_tag(EDGE, "length", 1, lengths);
+    auto synced_coords = mesh.sync_array(VERT, coords, 2);
+    auto synced_lengths = mesh.sync_array(EDGE, lengths, 1);
+    OMEGA_H_CHECK(comm->reduce_or(!(synced_coords == coords)));
+    TagSet tags;
+    tags[VERT].insert("coordinates");
+    tags[EDGE].insert("length");
+    mesh.sync_tags(tags);
+    OMEGA_H_CHECK(mesh.coords() == synced_coords);
+    OMEGA_H_CHECK(mesh.has_tag(EDGE, "length"));
+    OMEGA_H_CHECK(mesh.get_array<Real>(EDGE, "length") == synced_lengths);
+    /* synced alone, new coordinates still remove the cached lengths */
+    tags[EDGE].clear();
+    mesh.set_tag(VERT, "coordinates", coords, true);
+    mesh.sync_tags(tags);
+    OMEGA_H_CHECK(!mesh.has_tag(EDGE, "length"));
+  });
+}
+
+static void test_drop_ghost_layers(Library* lib) {
+  run_comm_threads(lib, 4, [](CommPtr comm) {
+    auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+    mesh.set_parting(OMEGA_H_GHOSTED);
+    auto migrated = mesh;
+    auto owned = collect_marked(mesh.owned(3));
+    auto owners = unmap(owned, mesh.ask_owners(3));
+    auto dist = Dist(comm, owners, mesh.nelems());
+    migrate_mesh(&migrated, dist, OMEGA_H_ELEM_BASED, false);
+    mesh.set_parting(OMEGA_H_ELEM_BASED);
+    /* dropping the ghosts in place must give what migration gives */
+    for (Int d = 0; d <= 3; ++d) {
+      OMEGA_H_CHECK(mesh.globals(d) == migrated.globals(d));
+      OMEGA_H_CHECK(mesh.ask_owners(d).ranks == migrated.ask_owners(d).ranks);
+      OMEGA_H_CHECK(mesh.ask_owners(d).idxs == migrated.ask_owners(d).idxs);
+    }
+    OMEGA_H_CHECK(mesh.ask_verts_of(3) == migrated.ask_verts_of(3));
+    OMEGA_H_CHECK(mesh.coords() == migrated.coords());
+  });
+}
+
+static void test_balance_by_hilbert(Library* lib) {
+  run_comm_threads(lib, 4, [](CommPtr comm) {
+    auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+    mesh.balance_by_hilbert();
+    OMEGA_H_CHECK(mesh.nglobal_ents(FACE) == 128);
+    OMEGA_H_CHECK(mesh.nglobal_ents(VERT) == 81);
+    OMEGA_H_CHECK(mesh.imbalance() < 1.1);
+    /* a balanced mesh is left where it is */
+    auto globals = mesh.globals(FACE);
+    mesh.balance_by_hilbert();
+    OMEGA_H_CHECK(mesh.globals(FACE) == globals);
+  });
+}
+
+static void test_shared_file(Library* lib) {
+  run_comm_threads(lib, 4, [](CommPtr comm) {
+    auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+    mesh.balance_by_hilbert();
+    binary::write_shared("shared.osh", &mesh);
+    auto mesh2 = binary::read_shared("shared.osh", comm);
+    OMEGA_H_CHECK(mesh == mesh2);
+  });
+  for (I32 nranks : {1, 3, 6}) {
+    run_comm_threads(lib, nranks, [](CommPtr comm) {
+      auto mesh = binary::read_shared("shared.osh", comm);
+      OMEGA_H_CHECK(mesh.nglobal_ents(VERT) == 81);
+      OMEGA_H_CHECK(mesh.nglobal_ents(EDGE) == 208);
+      OMEGA_H_CHECK(mesh.nglobal_ents(FACE) == 128);
+      auto owned = HostRead<I8>(mesh.owned(VERT));
+      auto class_dims = HostRead<I8>(mesh.get_array<I8>(VERT, "class_dim"));
+      LO nboundary_verts = 0;
+      for (LO v = 0; v < mesh.nverts(); ++v) {
+        if (owned[v] && class_dims[v] < 2) ++nboundary_verts;
+      }
+      OMEGA_H_CHECK(comm->allreduce(nboundary_verts, OMEGA_H_SUM) == 32);
+      OMEGA_H_CHECK(
+          comm->allreduce(get_sum(mesh.ask_sizes()), OMEGA_H_SUM) > 0.999);
+    });
+  }
+}
+
+static void test_write_async_threads(Library* lib) {
+  run_comm_threads(lib, 4, [](CommPtr comm) {
+    auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+    binary::write("sync_threads.osh", &mesh);
+    auto request = binary::write_async("async_threads.osh", &mesh);
+    /* the ranks keep communicating while their parts are written */
+    mesh.set_parting(OMEGA_H_GHOSTED);
+    OMEGA_H_CHECK(mesh.nglobal_ents(FACE) == 128);
+    request.wait();
+    auto sync_mesh = binary::read("sync_threads.osh", comm);
+    auto async_mesh = binary::read("async_threads.osh", comm);
+    OMEGA_H_CHECK(sync_mesh == async_mesh);
+    OMEGA_H_CHECK(binary::read_nparts("async_threads.osh", comm) == 4);
+  });
+}
+
+static void test_rebalance_diffusively(Library* lib) {
+  run_comm_threads(lib, 4, [](CommPtr comm) {
+    auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+    /* move half of the last rank's elements to its predecessor */
+    auto nelems = mesh.nelems();
+    auto rank = comm->rank();
+    Write<I32> dest_ranks(nelems);
+    auto f = OMEGA_H_LAMBDA(LO e) {
+      dest_ranks[e] = (rank == 3 && e < nelems / 2) ? 2 : rank;
+    };
+    parallel_for(nelems, f);
+    Dist elems2new;
+    elems2new.set_parent_comm(comm);
+    elems2new.set_dest_ranks(dest_ranks);
+    elems2new.set_roots2items(LOs(nelems + 1, 0, 1));
+    elems2new.set_dest_globals(mesh.globals(FACE));
+    migrate_mesh(&mesh, elems2new.invert(), OMEGA_H_ELEM_BASED, false);
+    OMEGA_H_CHECK(mesh.imbalance() > 1.1);
+    auto bytes = rebalance_diffusively(&mesh, 1.1);
+    OMEGA_H_CHECK(bytes > 0);
+    OMEGA_H_CHECK(mesh.nglobal_ents(FACE) == 128);
+    OMEGA_H_CHECK(mesh.imbalance() <= 1.1);
+    OMEGA_H_CHECK(rebalance_diffusively(&mesh, 1.1) == 0);
+  });
+}
+#endif
+
+static void test_cached_measures(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 2, 2, 0);
+  add_implied_metric_tag(&mesh);
+  auto lengths = mesh.ask_lengths();
+  mesh.ask_qualities();
+  mesh.ask_sizes();
+  OMEGA_H_CHECK(mesh.ask_lengths().data() == lengths.data());
+  mesh.set_coords(mesh.coords());
+  OMEGA_H_CHECK(mesh.has_tag(EDGE, "length"));
+  mesh.set_coords(deep_copy(mesh.coords()));
+  OMEGA_H_CHECK(!mesh.has_tag(EDGE, "length"));
+  OMEGA_H_CHECK(!mesh.has_tag(FACE, "quality"));
+  OMEGA_H_CHECK(!mesh.has_tag(FACE, "size"));
+  OMEGA_H_CHECK(mesh.ask_lengths() == lengths);
+  mesh.ask_qualities();
+  auto metrics = mesh.get_array<Real>(VERT, "metric");
+  mesh.remove_tag(VERT, "metric");
+  OMEGA_H_CHECK(!mesh.has_tag(FACE, "quality"));
+  mesh.add_tag(VERT, "metric", 3, metrics, true);
+  OMEGA_H_CHECK(mesh.ask_qualities() == measure_qualities(&mesh));
+}
+
 static void test_swap2d_topology(Library* lib) {
   auto mesh = Mesh(lib);
   build_box_internal(&mesh, OMEGA_H_SIMPLEX, 1., 1., 0., 1, 1, 0);
@@ -860,6 +1364,82 @@ static void test_swap3d_loop(Library* lib) {
   parallel_for(LO(1), f);
 }
 
+/* (n) tets around the edge from (0, 0, -1) to (0, 0, 1),
+   whose loop is a regular polygon of (n) vertices in the XY plane
+   centered at (offset, 0, 0) */
+static void build_edge_loop(Mesh* mesh, LO n, Real offset) {
+  HostWrite<Real> h_coords((n + 2) * 3);
+  for (LO i = 0; i < n; ++i) {
+    auto a = 2.0 * PI * Real(i) / Real(n);
+    h_coords[i * 3 + 0] = offset + std::cos(a);
+    h_coords[i * 3 + 1] = std::sin(a);
+    h_coords[i * 3 + 2] = 0.0;
+  }
+  for (LO i = 0; i < 2; ++i) {
+    h_coords[(n + i) * 3 + 0] = 0.0;
+    h_coords[(n + i) * 3 + 1] = 0.0;
+    h_coords[(n + i) * 3 + 2] = i ? 1.0 : -1.0;
+  }
+  HostWrite<LO> h_ev2v(n * 4);
+  for (LO i = 0; i < n; ++i) {
+    h_ev2v[i * 4 + 0] = i;
+    h_ev2v[i * 4 + 1] = (i + 1) % n;
+    h_ev2v[i * 4 + 2] = n;
+    h_ev2v[i * 4 + 3] = n + 1;
+  }
+  build_from_elems_and_coords(
+      mesh, OMEGA_H_SIMPLEX, REGION, h_ev2v.write(), h_coords.write());
+  classify_by_angles(mesh, PI / 4);
+  mesh->add_tag(VERT, "metric", 1, Reals(mesh->nverts(), 1.0));
+}
+
+static void test_swap3d_dp(Library* lib) {
+  /* on loops the tables cover, dynamic programming
+     finds a triangulation as good as the best one in the tables */
+  for (LO n = 4; n <= swap3d::MAX_EDGE_SWAP; ++n) {
+    auto mesh = Mesh(lib);
+    build_edge_loop(&mesh, n, 0.5);
+    auto edges2tets = mesh.ask_up(EDGE, REGION);
+    auto edges2edge_tets = edges2tets.a2ab;
+    auto edge_tets2tets = edges2tets.ab2b;
+    auto edge_tet_codes = edges2tets.codes;
+    auto edge_verts2verts = mesh.ask_verts_of(EDGE);
+    auto tet_verts2verts = mesh.ask_verts_of(REGION);
+    auto quality_measure = MetricElementQualities<3, 1>(&mesh);
+    auto length_measure = MetricEdgeLengths<3, 1>(&mesh);
+    auto axis = find_last(get_degrees(edges2edge_tets), n);
+    Write<Real> quals(2);
+    auto f = OMEGA_H_LAMBDA(LO) {
+      auto loop = swap3d::find_loop(edges2edge_tets, edge_tets2tets,
+          edge_tet_codes, edge_verts2verts, tet_verts2verts, axis);
+      quals[0] =
+          swap3d::choose(loop, quality_measure, length_measure, 10.0).quality;
+      quals[1] = swap3d::triangulate_loop(
+          loop, quality_measure, length_measure, 10.0)
+                     .quality;
+    };
+    parallel_for(LO(1), f);
+    auto h_quals = HostRead<Real>(Reals(quals));
+    OMEGA_H_CHECK(h_quals[0] > 0.0);
+    OMEGA_H_CHECK(are_close(h_quals[0], h_quals[1]));
+  }
+  /* larger loops are swapped without the tables.
+     the edge passes close to one side of this loop,
+     so removing it gets rid of the worst tets */
+  LO const n = 12;
+  auto mesh = Mesh(lib);
+  build_edge_loop(&mesh, n, 0.9);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.min_quality_desired = 1.0;
+  opts.max_length_allowed = 10.0;
+  auto old_minqual = get_min(mesh.ask_qualities());
+  OMEGA_H_CHECK(swap_edges(&mesh, opts));
+  OMEGA_H_CHECK(mesh.nelems() == 2 * (n - 2));
+  OMEGA_H_CHECK(mesh.nedges() == 3 * n + (n - 3));
+  OMEGA_H_CHECK(get_min(mesh.ask_qualities()) > old_minqual);
+}
+
 static void build_empty_mesh(Mesh* mesh, Int dim) {
   build_from_elems_and_coords(mesh, OMEGA_H_SIMPLEX, dim, LOs({}), Reals({}));
 }
@@ -888,6 +1468,134 @@ static void test_file(Library* lib) {
   }
 }
 
+/* keeps bytes in memory but cannot report a position, like a pipe */
+class UnseekableBuffer : public std::streambuf {
+ public:
+  std::string data;
+  void rewind() { setg(&data[0], &data[0], &data[0] + data.size()); }
+
+ protected:
+  int_type overflow(int_type c) override {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      data.push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(char const* s, std::streamsize n) override {
+    data.append(s, std::size_t(n));
+    return n;
+  }
+};
+
+static void test_file_unseekable(Library* lib) {
+  auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  for (auto compress : {false, true}) {
+    UnseekableBuffer buffer;
+    std::ostream out(&buffer);
+    OMEGA_H_CHECK(out.tellp() == std::ostream::pos_type(-1));
+    binary::write(out, &mesh0, compress);
+    OMEGA_H_CHECK(out.good());
+    std::stringstream seekable;
+    binary::write(seekable, &mesh0, compress);
+    OMEGA_H_CHECK(buffer.data == seekable.str());
+    buffer.rewind();
+    std::istream in(&buffer);
+    Mesh mesh1(lib);
+    mesh1.set_comm(lib->world());
+    binary::read(in, &mesh1, binary::latest_version);
+    OMEGA_H_CHECK(in.good());
+    OMEGA_H_CHECK(mesh0 == mesh1);
+  }
+}
+
+#if defined(__linux__) && !defined(OMEGA_H_USE_KOKKOSCORE)
+/* whether (p) points into memory mapped from a file whose path
+   ends in (suffix), according to /proc/self/maps */
+static bool is_mapped_from(void const* p, std::string const& suffix) {
+  auto addr = reinterpret_cast<std::uintptr_t>(p);
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  while (std::getline(maps, line)) {
+    std::istringstream fields(line);
+    std::uintptr_t begin, end;
+    char dash;
+    std::string perms, offset, device, inode, path;
+    fields >> std::hex >> begin >> dash >> end;
+    fields >> perms >> offset >> device >> inode >> path;
+    if (begin <= addr && addr < end) return ends_with(path, suffix);
+  }
+  return false;
+}
+#endif
+
+static void test_read_mapped(Library* lib) {
+  auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  for (auto compress : {false, true}) {
+    binary::write("mapped.osh", &mesh0, compress);
+    auto mesh1 = binary::read_mapped("mapped.osh", lib->world());
+    OMEGA_H_CHECK(mesh0 == mesh1);
+#if defined(__linux__) && !defined(OMEGA_H_USE_KOKKOSCORE)
+    /* uncompressed arrays are used in place, not copied */
+    auto part = "mapped.osh/" + to_string(lib->world()->rank()) + ".osh";
+    auto coords = mesh1.coords();
+    if (!compress) OMEGA_H_CHECK(is_mapped_from(coords.data(), part));
+#endif
+  }
+  /* arrays taken from the mapping outlive the mesh that held them */
+  binary::write("mapped.osh", &mesh0, false);
+  Reals coords;
+  {
+    auto mesh1 = binary::read_mapped("mapped.osh", lib->world());
+    coords = mesh1.coords();
+  }
+  OMEGA_H_CHECK(coords == mesh0.coords());
+}
+
+static void test_write_async(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  binary::write("sync.osh", &mesh);
+  auto request = binary::write_async("async.osh", &mesh);
+  /* the mesh can change while it is being written */
+  mesh.set_coords(multiply_each_by(mesh.coords(), 2.0));
+  request.wait();
+  request.wait();
+  auto sync_mesh = binary::read("sync.osh", lib->world());
+  auto async_mesh = binary::read("async.osh", lib->world());
+  OMEGA_H_CHECK(sync_mesh == async_mesh);
+}
+
+static void test_read_tags(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  mesh.add_tag(VERT, "field", 1, Reals(mesh.nverts(), 1.0));
+  for (auto compress : {false, true}) {
+    binary::write("tags.osh", &mesh, compress);
+    TagSet tags;
+    tags[VERT].insert("coordinates");
+    tags[REGION].insert("class_id");
+    auto some = binary::read("tags.osh", lib->world(), tags);
+    OMEGA_H_CHECK(some.ntags(VERT) == 1);
+    OMEGA_H_CHECK(some.ntags(EDGE) == 0);
+    OMEGA_H_CHECK(some.ntags(REGION) == 1);
+    OMEGA_H_CHECK(some.coords() == mesh.coords());
+    OMEGA_H_CHECK(some.get_array<ClassId>(REGION, "class_id") ==
+                  mesh.get_array<ClassId>(REGION, "class_id"));
+    auto lazy = binary::read_lazy("tags.osh", lib->world());
+    OMEGA_H_CHECK(lazy.get_array<Real>(VERT, "field") ==
+                  mesh.get_array<Real>(VERT, "field"));
+    OMEGA_H_CHECK(lazy == mesh);
+  }
+  /* overwriting a lazy tag does not load it, even when its file
+     is gone */
+  binary::write("lazy_tags.osh", &mesh);
+  auto lazy = binary::read_lazy("lazy_tags.osh", lib->world());
+  OMEGA_H_CHECK(!lazy.get_tag<Real>(VERT, "field")->is_loaded());
+  auto part = "lazy_tags.osh/" + to_string(lib->world()->rank()) + ".osh";
+  OMEGA_H_CHECK(std::remove(part.c_str()) == 0);
+  auto twos = Reals(mesh.nverts(), 2.0);
+  lazy.set_tag(VERT, "field", twos);
+  OMEGA_H_CHECK(lazy.get_array<Real>(VERT, "field") == twos);
+}
+
 static void test_xml() {
   xml::Tag tag;
   OMEGA_H_CHECK(!xml::parse_tag("AQAAAAAAAADABg", &tag));
@@ -1286,8 +1994,11 @@ int main(int argc, char** argv) {
   test_most_normal();
   test_repro_sum();
   test_sort();
+  test_sort_vs_stable_sort();
   test_sort_small_range();
   test_scan();
+  test_parallel_for_dynamic();
+  test_pool();
   test_intersect_metrics();
   test_fan_and_funnel();
   test_permute();
@@ -1297,6 +2008,10 @@ int main(int argc, char** argv) {
   test_form_uses();
   test_reflect_down();
   test_find_unique();
+  test_dedup_by_hashing(&lib);
+  test_update_up_adj(&lib);
+  test_refine_in_batch(&lib, 2);
+  test_refine_in_batch(&lib, 3);
   test_hilbert();
   test_bbox();
   test_build(&lib);
@@ -1313,9 +2028,32 @@ int main(int argc, char** argv) {
   test_refine_qualities(&lib);
   test_mark_up_down(&lib);
   test_compare_meshes(&lib);
+  test_tag_lookup(&lib);
+  test_cached_measures(&lib);
+  test_limit_gradation(&lib);
+  test_laplacian_cg(&lib, 2);
+  test_laplacian_cg(&lib, 3);
+  test_smooth_snap_warp(&lib);
+  test_inverse_dist(&lib);
+  test_exch_tags(&lib);
+  test_exch_begin(&lib);
+#ifndef OMEGA_H_USE_MPI
+  test_comm_threads(&lib);
+  test_sync_tags(&lib);
+  test_drop_ghost_layers(&lib);
+  test_balance_by_hilbert(&lib);
+  test_rebalance_diffusively(&lib);
+  test_shared_file(&lib);
+  test_write_async_threads(&lib);
+#endif
   test_swap2d_topology(&lib);
   test_swap3d_loop(&lib);
+  test_swap3d_dp(&lib);
   test_file(&lib);
+  test_file_unseekable(&lib);
+  test_read_mapped(&lib);
+  test_write_async(&lib);
+  test_read_tags(&lib);
   test_xml();
   test_read_vtu(&lib);
   test_interpolate_metrics();